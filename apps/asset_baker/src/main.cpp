@@ -0,0 +1,67 @@
+#include "assets/asset_baker.hpp"
+
+#include <mill/mill.hpp>
+
+#include <string>
+#include <exception>
+#include <iostream>
+#include <filesystem>
+#include <string_view>
+
+namespace
+{
+    void print_usage()
+    {
+        std::cout << "Usage: asset_baker <project_dir> [--threads <count>]\n"
+                     "  Imports every asset in <project_dir>/assets and bakes them into <project_dir>/data.\n"
+                     "  --threads <count>  Number of import & export threads. Defaults to one per hardware thread.\n";
+    }
+}
+
+/*
+    Headless asset baker, so data banks can be baked without a window or GPU (eg. on a build farm).
+    Returns 0 if every asset was baked, 1 if any failed and 2 if the arguments are invalid.
+*/
+int main(int argc, char** argv)
+{
+    std::filesystem::path project_dir{};
+    mill::u32 thread_count{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+        {
+            try
+            {
+                thread_count = static_cast<mill::u32>(std::stoul(argv[++i]));
+            }
+            catch (const std::exception&)
+            {
+                print_usage();
+                return 2;
+            }
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            print_usage();
+            return 0;
+        }
+        else if (project_dir.empty() && !arg.starts_with("-"))
+        {
+            project_dir = arg;
+        }
+        else
+        {
+            print_usage();
+            return 2;
+        }
+    }
+
+    if (project_dir.empty())
+    {
+        print_usage();
+        return 2;
+    }
+
+    return mill::asset_browser::bake_project(project_dir, thread_count) ? 0 : 1;
+}
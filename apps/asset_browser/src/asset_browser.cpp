@@ -5,12 +5,14 @@
 #include "assets/asset_metadata.hpp"
 #include "assets/mesh_importer.hpp"
 #include "assets/mesh_exporter.hpp"
+#include "assets/asset_baker.hpp"
 
 #include <mill/mill.hpp>
 #include <imgui.h>
 #include <portable-file-dialogs.h>
 
 #include <string>
+#include <chrono>
 #include <format>
 #include <filesystem>
 
@@ -40,12 +42,6 @@ auto get_converted_mem_str(mill::u64 in_bytes) -> std::string
 
 namespace mill::asset_browser
 {
-    void handle_static_mesh(const std::string& filename)
-    {
-        auto mesh = import_static_mesh(filename);
-        export_static_mesh(*mesh, filename + ".bin");
-    }
-
     void AssetBrowserApp::initialise()
     {
         auto& events = Engine::get()->get_events();
@@ -70,6 +66,7 @@ namespace mill::asset_browser
         m_renderer->initialise();
 
         m_assetBrowserView.inititialise(m_assetRegistry);
+        m_assetSettingsView.initialise(m_importCache);
 
         m_assetBrowserView.OnAssetSelected.connect(
             [this](u64 asset_id)
@@ -82,38 +79,14 @@ namespace mill::asset_browser
             });
 
         m_assetPreviewView.init(g_SceneViewId);
-
-#if 0
-		// Load and export all assets in asset directory
-        for (auto& dir_entry : std::filesystem::recursive_directory_iterator(g_AssetPath))
-        {
-            if (!dir_entry.is_regular_file())
-            {
-                continue;
-            }
-
-            const auto filePath = dir_entry.path();
-            const auto ext = filePath.extension().string();
-
-            const auto asset_type = get_asset_type(ext);
-            if (asset_type == AssetType::eNone)
-            {
-                continue;
-            }
-
-            LOG_INFO("AssetBrowser - Importing asset <{}>", filePath.string());
-
-            switch (asset_type)
-            {
-                case AssetType::eModel: handle_static_mesh(filePath.string()); break;
-                default: break;
-            }
-        }
-#endif  // 0
     }
 
     void AssetBrowserApp::shutdown()
     {
+        // Jobs reference the pending assets & the import cache
+        m_importJobs.wait();
+        m_importCache.close();
+
         shutdown_imgui();
 
         m_renderer->shutdown();
@@ -129,6 +102,8 @@ namespace mill::asset_browser
 
         ImGui::NewFrame();
 
+        update_asset_imports();
+
         if (ImGui::BeginMainMenuBar())
         {
             if (ImGui::BeginMenu("File"))
@@ -152,8 +127,9 @@ namespace mill::asset_browser
                     import_assets();
                 }
                 ImGui::Separator();
-                if (ImGui::MenuItem("Bake & Export"))
+                if (ImGui::MenuItem("Bake & Export", nullptr, false, !m_isScanning))
                 {
+                    bake_assets();
                 }
 
                 ImGui::EndMenu();
@@ -184,6 +160,13 @@ namespace mill::asset_browser
             ImGui::Text("Device Memory: %s/%s",
                         get_converted_mem_str(mem_stats.DeviceTotalUsage).c_str(),
                         get_converted_mem_str(mem_stats.DeviceTotalBudget).c_str());
+
+            const auto import_cache_stats = m_importCache.get_stats();
+            ImGui::Text("Project Scan: %.1fms", m_lastScanTimeMs);
+            ImGui::Text("Import Cache: %u hits, %u imported, %u source files hashed",
+                        import_cache_stats.hitCount,
+                        import_cache_stats.missCount,
+                        import_cache_stats.hashedCount);
         }
         ImGui::End();
 
@@ -193,6 +176,7 @@ namespace mill::asset_browser
         m_assetBrowserView.render();
         m_assetSettingsView.render();
         m_assetPreviewView.render();
+        render_import_progress();
 
         rhi::begin_frame();
         {
@@ -214,11 +198,18 @@ namespace mill::asset_browser
     {
         LOG_INFO("AssetBrowser - Reloading project.");
 
-        m_assetRegistry.clear();
+        // Any imports still running are for the previous scan
+        m_importJobs.wait();
+        m_importJobs.clear();
+        m_pendingAssets.clear();
 
-        scan_for_and_register_assets(m_projectDir / "assets");
+        m_assetSettingsView.set_active_asset(nullptr);
+        m_assetRegistry.clear();
+        m_importCache.reset_stats();
 
-        m_assetBrowserView.refresh();
+        m_isScanning = true;
+        m_scanStartTime = std::chrono::steady_clock::now();
+        scan_for_and_import_assets(m_projectDir / "assets");
     }
 
     void AssetBrowserApp::import_assets()
@@ -250,6 +241,9 @@ namespace mill::asset_browser
 
         for (const auto& file : assets_to_import)
             import_asset(file, target_dir);
+
+        // A single rescan picks up every new asset. Unchanged assets are import cache hits.
+        reload_project();
     }
 
     void AssetBrowserApp::import_asset(const fs::path& asset_filename, const fs::path& target_dir)
@@ -267,8 +261,14 @@ namespace mill::asset_browser
 
         const auto meta_filename = fs::path(target_asset_filename).concat(".meta");
         AssetMetadata::to_file(metadata, meta_filename);
+    }
 
-        reload_project();
+    void AssetBrowserApp::bake_assets()
+    {
+        if (m_projectDir.empty())
+            return;
+
+        asset_browser::bake_assets(m_assetRegistry, m_projectDir / "data", m_projectDir / "intermediate");
     }
 
     void AssetBrowserApp::event_callback(const Event& event)
@@ -382,33 +382,97 @@ namespace mill::asset_browser
         LOG_INFO("AssetBrowser - Opening project dir: {}.", project_dir.string());
 
         m_projectDir = project_dir;
+        m_importCache.open(m_projectDir / "intermediate" / "import_cache");
 
         m_assetBrowserView.set_root_dir(assets_dir);
 
         reload_project();
     }
 
-    void AssetBrowserApp::scan_for_and_register_assets(const fs::path& dir_to_scan)
+    void AssetBrowserApp::scan_for_and_import_assets(const fs::path& dir_to_scan)
+    {
+        // Not touched again until every job has finished, so the jobs can hold references into it
+        m_pendingAssets = scan_for_asset_metadata(dir_to_scan);
+        for (auto& metadata : m_pendingAssets)
+        {
+            m_importJobs.add_job(metadata.name, [this, &metadata] { return metadata.import_asset(m_importCache); });
+        }
+    }
+
+    void AssetBrowserApp::update_asset_imports()
     {
-        LOG_INFO("AssetBrowser - Scanning for assets in directory <{}>.", dir_to_scan.string());
+        if (!m_isScanning || !m_importJobs.is_idle())
+        {
+            return;
+        }
+
+        for (const auto& metadata : m_pendingAssets)
+        {
+            m_assetRegistry.register_metadata(metadata);
+        }
+        m_importCache.save();
+        m_lastScanTimeMs = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - m_scanStartTime).count();
+
+        const auto import_cache_stats = m_importCache.get_stats();
+        LOG_INFO("AssetBrowser - Scanned project in {:.1f}ms on {} threads ({} import cache hits, {} imported, {} source files hashed, {} failed).",
+                 m_lastScanTimeMs,
+                 m_importJobs.get_thread_count(),
+                 import_cache_stats.hitCount,
+                 import_cache_stats.missCount,
+                 import_cache_stats.hashedCount,
+                 m_importJobs.get_failed_count());
+
+        m_importJobs.clear();
+        m_pendingAssets.clear();
+        m_isScanning = false;
+        m_assetBrowserView.refresh();
+    }
 
-        for (const auto& dir_entry : fs::recursive_directory_iterator(dir_to_scan))
+    void AssetBrowserApp::render_import_progress()
+    {
+        const auto job_count = m_importJobs.get_job_count();
+        if (job_count == 0)
         {
-            if (!dir_entry.is_regular_file())
-                continue;
+            return;
+        }
 
-            const auto& file_path = dir_entry.path();
-            const auto& file_name = file_path.filename();
+        if (ImGui::Begin("Import Progress"))
+        {
+            const auto finished_count = m_importJobs.get_finished_count();
+            const auto overlay = std::format("{}/{}", finished_count, job_count);
+            ImGui::ProgressBar(CAST_F32(finished_count) / CAST_F32(job_count), ImVec2(-1.0f, 0.0f), overlay.c_str());
 
-            const bool is_metadata_file = file_name.string().ends_with(".meta");
-            if (!is_metadata_file)
-                continue;
+            if (ImGui::BeginTable("Imports", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+            {
+                ImGui::TableSetupColumn("Asset");
+                ImGui::TableSetupColumn("State");
+                ImGui::TableSetupColumn("Time");
+                ImGui::TableHeadersRow();
 
-            LOG_DEBUG("AssetBrowser - Found asset metadata: {}.", file_path.string());
+                for (const auto& progress : m_importJobs.get_progress())
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(progress.name.c_str());
+                    ImGui::TableNextColumn();
+                    switch (progress.state)
+                    {
+                        case AssetJobState::eQueued: ImGui::TextDisabled("Queued"); break;
+                        case AssetJobState::eRunning: ImGui::TextUnformatted("Importing..."); break;
+                        case AssetJobState::eSucceeded: ImGui::TextUnformatted("Done"); break;
+                        case AssetJobState::eFailed: ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Failed"); break;
+                    }
+                    ImGui::TableNextColumn();
+                    if (progress.state == AssetJobState::eSucceeded || progress.state == AssetJobState::eFailed)
+                    {
+                        ImGui::Text("%.1fms", progress.durationMs);
+                    }
+                }
 
-            const auto metadata = AssetMetadata::from_file(file_path);
-            m_assetRegistry.register_metadata(metadata);
+                ImGui::EndTable();
+            }
         }
+        ImGui::End();
     }
 
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "assets/asset_registry.hpp"
+#include "assets/asset_import_cache.hpp"
+#include "assets/asset_job_queue.hpp"
 #include "views/asset_browser_view.hpp"
 #include "views/asset_settings_view.hpp"
 #include "views/asset_preview_view.hpp"
@@ -8,6 +10,8 @@
 
 #include <mill/mill.hpp>
 
+#include <chrono>
+#include <vector>
 #include <filesystem>
 
 namespace mill::asset_browser
@@ -25,8 +29,11 @@ namespace mill::asset_browser
         void reload_project();
 
         void import_assets();
+        /* Copies the asset into `target_dir` and writes its metadata. It is imported by the next reload_project(). */
         void import_asset(const fs::path& asset_filename, const fs::path& target_dir);
 
+        void bake_assets();
+
     private:
         void event_callback(const Event& event);
 
@@ -38,7 +45,10 @@ namespace mill::asset_browser
         void open_project();
         void open_project(const fs::path& project_dir);
 
-        void scan_for_and_register_assets(const fs::path& dir_to_scan);
+        /* Queues an import job per asset found in `dir_to_scan`. They are registered by update_asset_imports() once all have finished. */
+        void scan_for_and_import_assets(const fs::path& dir_to_scan);
+        void update_asset_imports();
+        void render_import_progress();
 
     private:
         platform::HandleWindow m_windowHandle{ nullptr };
@@ -50,6 +60,12 @@ namespace mill::asset_browser
         const u64 g_MainViewId = "main_view"_hs;
 
         AssetRegistry m_assetRegistry{};
+        AssetImportCache m_importCache{};
+        AssetJobQueue m_importJobs{};
+        std::vector<AssetMetadata> m_pendingAssets{};  // Being imported by `m_importJobs`, registered once they have all finished
+        bool m_isScanning{ false };
+        std::chrono::steady_clock::time_point m_scanStartTime{};
+        f64 m_lastScanTimeMs{};  // Time taken to scan & import the project's assets the last time it was (re)loaded
         AssetBrowserView m_assetBrowserView{};
         AssetSettingView m_assetSettingsView{};
         AssetPreviewView m_assetPreviewView{};
@@ -0,0 +1,280 @@
+#include "asset_baker.hpp"
+
+#include "asset_metadata.hpp"
+#include "asset_export_settings.hpp"
+#include "data_bank_packer.hpp"
+#include "asset_job_queue.hpp"
+#include "asset_import_cache.hpp"
+
+#include <mill/resources/resource_registry.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <format>
+#include <fstream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace mill::asset_browser
+{
+    namespace
+    {
+        /* Copies the export from the import cache if there is one, so the asset does not need to have been imported. */
+        bool export_resource(ExportSettings& settings, const std::filesystem::path& filename)
+        {
+            const auto& cached_filename = settings.get_cached_filename();
+            if (cached_filename.empty())
+            {
+                return settings.export_resource(filename);
+            }
+
+            std::error_code error{};
+            std::filesystem::copy_file(cached_filename, filename, std::filesystem::copy_options::overwrite_existing, error);
+            if (error)
+            {
+                LOG_ERROR("AssetBrowser - AssetBaker - Failed to copy cached export <{}>: {}", cached_filename.string(), error.message());
+                return false;
+            }
+            return true;
+        }
+
+        /* Compresses an exported resource in-place. Left uncompressed if the codec fails or does not make it smaller. */
+        void compress_data_bank(const std::filesystem::path& filename, CompressionCodec codec, ResourceMetadata& metadata)
+        {
+            std::vector<std::byte> data(metadata.binarySize);
+            {
+                std::ifstream file(filename, std::ios::binary);
+                file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                if (!file)
+                {
+                    LOG_ERROR("AssetBrowser - AssetBaker - Failed to read <{}> for compression.", filename.string());
+                    return;
+                }
+            }
+
+            const auto compressed_data = compress(codec, data);
+            if (compressed_data.empty() || compressed_data.size() >= data.size())
+            {
+                LOG_DEBUG("AssetBrowser - AssetBaker - Resource <{}> left uncompressed.", metadata.id);
+                return;
+            }
+
+            std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(compressed_data.data()), static_cast<std::streamsize>(compressed_data.size()));
+
+            metadata.codec = codec;
+            metadata.binarySize = compressed_data.size();
+
+            LOG_DEBUG("AssetBrowser - AssetBaker - Resource <{}> compressed with {}: {}B -> {}B.",
+                      metadata.id,
+                      get_codec_name(codec),
+                      metadata.uncompressedSize,
+                      metadata.binarySize);
+        }
+    }
+
+    bool bake_assets(const AssetRegistry& registry,
+                     const std::filesystem::path& data_dir,
+                     const std::filesystem::path& intermediate_dir,
+                     u32 thread_count)
+    {
+        LOG_INFO("AssetBrowser - AssetBaker - Baking assets to <{}>.", data_dir.string());
+
+        std::filesystem::create_directories(data_dir);
+        std::filesystem::create_directories(intermediate_dir);
+
+        // Ordered by resource id, so the bake does not depend on the order assets were registered in
+        std::vector<std::pair<const AssetMetadata*, ExportSettings*>> exports{};
+        for (const auto& [asset_id, asset_metadata] : registry.get_all_metadata())
+        {
+            for (const auto& settings : asset_metadata.exportSettings)
+            {
+                exports.emplace_back(&asset_metadata, settings.get());
+            }
+        }
+        std::sort(exports.begin(),
+                  exports.end(),
+                  [](const auto& lhs, const auto& rhs) { return lhs.second->get_resource_id() < rhs.second->get_resource_id(); });
+
+        // Export & compress each resource on its own, in parallel, then pack them all into data banks
+        std::vector<ResourceMetadata> resources(exports.size());
+        std::vector<DataBankPackEntry> pack_entries(exports.size());
+        {
+            AssetJobQueue jobs(thread_count);
+            for (sizet i = 0; i < exports.size(); ++i)
+            {
+                const auto& [asset_metadata, settings] = exports[i];
+                const auto job_name = std::format("Export {} ({})", asset_metadata->name, settings->get_name());
+                jobs.add_job(job_name,
+                             [&, i]
+                             {
+                                 auto& [asset, export_settings] = exports[i];
+                                 const auto resource_id = export_settings->get_resource_id();
+                                 const auto data_filename = intermediate_dir / std::format("{}.bin", resource_id);
+                                 if (!export_resource(*export_settings, data_filename))
+                                 {
+                                     LOG_WARN("AssetBrowser - AssetBaker - Asset <{}> settings <{}> has no resource to export.",
+                                              asset->name,
+                                              export_settings->get_name());
+                                     return false;
+                                 }
+
+                                 auto& metadata = resources[i];
+                                 metadata.id = resource_id;
+                                 metadata.typeId = export_settings->get_resource_type();
+                                 metadata.binaryOffset = 0;
+                                 metadata.binarySize = std::filesystem::file_size(data_filename);
+                                 metadata.uncompressedSize = metadata.binarySize;
+                                 metadata.flags = export_settings->get_resource_flags();
+
+                                 const auto codec = export_settings->get_compression_codec();
+                                 if (codec != CompressionCodec::eNone)
+                                 {
+                                     compress_data_bank(data_filename, codec, metadata);
+                                 }
+
+                                 pack_entries[i] = { nullptr, data_filename, export_settings->get_pack_group() };
+                                 return true;
+                             });
+            }
+            jobs.wait();
+
+            LOG_INFO("AssetBrowser - AssetBaker - Exported {} resources on {} threads ({} failed).",
+                     exports.size(),
+                     jobs.get_thread_count(),
+                     jobs.get_failed_count());
+        }
+
+        // Drop the resources that failed to export. Their metadata id is left as 0.
+        std::erase_if(pack_entries, [&](const auto& entry) { return entry.sourceFilename.empty(); });
+        std::erase_if(resources, [](const auto& metadata) { return metadata.id == 0; });
+        ASSERT(pack_entries.size() == resources.size());
+
+        // Only point the entries at their metadata now that `resources` has stopped changing
+        for (sizet i = 0; i < pack_entries.size(); ++i)
+        {
+            pack_entries[i].metadata = &resources[i];
+        }
+        if (!pack_data_banks(pack_entries, data_dir))
+        {
+            LOG_ERROR("AssetBrowser - AssetBaker - Failed to pack data banks.");
+            return false;
+        }
+
+        write_metadata_bank(resources, data_dir / g_MetadataBankFilename);
+        if (!ResourceRegistry::write(data_dir / g_ResourceRegistryFilename, resources))
+        {
+            LOG_ERROR("AssetBrowser - AssetBaker - Failed to write resource registry.");
+            return false;
+        }
+        remove_stale_data_banks(resources, data_dir);
+
+        LOG_INFO("AssetBrowser - AssetBaker - Baked {} resources.", resources.size());
+        return true;
+    }
+
+    bool bake_project(const std::filesystem::path& project_dir, u32 thread_count)
+    {
+        LOG_INFO("AssetBrowser - AssetBaker - Baking project <{}>.", project_dir.string());
+
+        const auto assets_dir = project_dir / "assets";
+        if (!std::filesystem::exists(assets_dir))
+        {
+            LOG_ERROR("AssetBrowser - AssetBaker - Project <{}> has no assets directory.", project_dir.string());
+            return false;
+        }
+
+        AssetImportCache import_cache{};
+        import_cache.open(project_dir / "intermediate" / "import_cache");
+
+        auto assets = scan_for_asset_metadata(assets_dir);
+        u32 failed_count{};
+        {
+            AssetJobQueue jobs(thread_count);
+            for (auto& asset_metadata : assets)
+            {
+                jobs.add_job(std::format("Import {}", asset_metadata.name),
+                             [&asset_metadata, &import_cache] { return asset_metadata.import_asset(import_cache); });
+            }
+            jobs.wait();
+            failed_count = jobs.get_failed_count();
+
+            const auto cache_stats = import_cache.get_stats();
+            LOG_INFO("AssetBrowser - AssetBaker - Imported {} assets on {} threads ({} import cache hits, {} imported, {} failed).",
+                     assets.size(),
+                     jobs.get_thread_count(),
+                     cache_stats.hitCount,
+                     cache_stats.missCount,
+                     failed_count);
+        }
+        import_cache.save();
+
+        AssetRegistry registry{};
+        for (const auto& asset_metadata : assets)
+        {
+            registry.register_metadata(asset_metadata);
+        }
+
+        if (!bake_assets(registry, project_dir / "data", project_dir / "intermediate", thread_count))
+        {
+            return false;
+        }
+
+        // Everything that could be imported is still baked, but the bake is incomplete
+        if (failed_count > 0)
+        {
+            LOG_ERROR("AssetBrowser - AssetBaker - {} assets failed to import.", failed_count);
+            return false;
+        }
+        return true;
+    }
+
+    void write_metadata_bank(std::span<const ResourceMetadata> resources, const std::filesystem::path& filename)
+    {
+        YAML::Emitter out{};
+
+        out << YAML::BeginMap;
+        out << YAML::Key << "resources";
+        out << YAML::BeginSeq;
+        for (const auto& metadata : resources)
+        {
+            out << YAML::BeginMap;
+            out << YAML::Key << "id" << YAML::Value << metadata.id;
+            out << YAML::Key << "type" << YAML::Value << metadata.typeId;
+            out << YAML::Key << "data_bank" << YAML::Value << metadata.binaryFile;
+            out << YAML::Key << "data_offset" << YAML::Value << metadata.binaryOffset;
+            out << YAML::Key << "data_size" << YAML::Value << metadata.binarySize;
+            if (metadata.codec != CompressionCodec::eNone)
+            {
+                out << YAML::Key << "codec" << YAML::Value << static_cast<u32>(metadata.codec);
+                out << YAML::Key << "uncompressed_size" << YAML::Value << metadata.uncompressedSize;
+            }
+            out << YAML::Key << "flags" << YAML::Value << static_cast<u32>(static_cast<ResourceFlags::MaskType>(metadata.flags));
+            if (!metadata.dependencies.empty())
+            {
+                out << YAML::Key << "dependencies" << YAML::Value << YAML::Flow << metadata.dependencies;
+            }
+            out << YAML::EndMap;
+        }
+        out << YAML::EndSeq;
+        out << YAML::EndMap;
+
+        // Written to a temporary file then moved into place, so a running engine never hot reloads a partially written bank
+        auto temp_filename = filename;
+        temp_filename += ".tmp";
+        {
+            std::ofstream file(temp_filename, std::ios::trunc);
+            file << out.c_str();
+        }
+
+        std::error_code error{};
+        std::filesystem::rename(temp_filename, filename, error);
+        if (error)
+        {
+            LOG_ERROR("AssetBrowser - AssetBaker - Failed to replace metadata bank <{}>: {}", filename.string(), error.message());
+            std::filesystem::remove(temp_filename, error);
+        }
+    }
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "asset_registry.hpp"
+
+#include <mill/mill.hpp>
+
+#include <span>
+#include <filesystem>
+
+namespace mill::asset_browser
+{
+    constexpr auto* g_MetadataBankFilename = "metadata_bank_0.yaml";
+
+    /*
+        Exports the resources of every registered asset into `intermediate_dir`, packs them into data banks in `data_dir`, then writes
+        the metadata bank and the compiled resource registry describing them.
+    */
+    bool bake_assets(const AssetRegistry& registry,
+                     const std::filesystem::path& data_dir,
+                     const std::filesystem::path& intermediate_dir,
+                     u32 thread_count = 0);
+
+    /*
+        Imports every asset in the project's `assets` directory, through its import cache, then bakes them into its `data` directory.
+        Does not need a window or the RHI, so it can be run headless, eg. by CI. A `thread_count` of 0 uses a thread per hardware thread.
+    */
+    bool bake_project(const std::filesystem::path& project_dir, u32 thread_count = 0);
+
+    /* Writes resource metadata in the YAML metadata bank format read by the engine's ResourceManager. */
+    void write_metadata_bank(std::span<const ResourceMetadata> resources, const std::filesystem::path& filename);
+}
@@ -5,7 +5,9 @@
 
 #include <mill/mill.hpp>
 
+#ifndef MILL_HEADLESS
 #include <imgui.h>
+#endif
 
 namespace mill::asset_browser
 {
@@ -14,6 +16,14 @@ namespace mill::asset_browser
     void ExportSettings::write(YAML::Emitter& out)
     {
         out << YAML::Key << "name" << YAML::Key << m_name;
+        if (!m_packGroup.empty())
+            out << YAML::Key << "pack_group" << YAML::Key << m_packGroup;
+
+        write_import_settings(out);
+    }
+
+    void ExportSettings::write_import_settings(YAML::Emitter& out)
+    {
         out << YAML::Key << "resource_id" << YAML::Key << m_resourceId;
     }
 
@@ -23,12 +33,17 @@ namespace mill::asset_browser
             m_name = settings_root_node["name"].as<std::string>();
         if (settings_root_node["resource_id"])
             m_resourceId = settings_root_node["resource_id"].as<u64>();
+        if (settings_root_node["pack_group"])
+            m_packGroup = settings_root_node["pack_group"].as<std::string>();
     }
 
+#ifndef MILL_HEADLESS
     void ExportSettings::render()
     {
         ImGui::Text("Resource Id: %i", m_resourceId);
+        ImGui::Text("Pack Group: %s", m_packGroup.empty() ? "<common>" : m_packGroup.c_str());
     }
+#endif
 
     auto ExportSettings::get_name() const -> const std::string&
     {
@@ -40,16 +55,36 @@ namespace mill::asset_browser
         return m_resourceId;
     }
 
+    auto ExportSettings::get_compression_codec() const -> CompressionCodec
+    {
+        return CompressionCodec::eZstd;
+    }
+
     auto ExportSettings::get_resource_flags() const -> ResourceFlags
     {
         return m_resourceFlags;
     }
 
+    auto ExportSettings::get_pack_group() const -> const std::string&
+    {
+        return m_packGroup;
+    }
+
     auto ExportSettings::get_resource() -> const Shared<Resource>&
     {
         return m_resource;
     }
 
+    auto ExportSettings::get_cached_filename() const -> const fs::path&
+    {
+        return m_cachedFilename;
+    }
+
+    void ExportSettings::set_cached_filename(const fs::path& filename)
+    {
+        m_cachedFilename = filename;
+    }
+
     void ExportSettings::set_resource(const Shared<Resource>& resource)
     {
         m_resource = resource;
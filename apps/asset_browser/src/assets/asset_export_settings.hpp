@@ -16,19 +16,37 @@ namespace mill::asset_browser
 
         virtual ~ExportSettings() = default;
 
-        virtual void write(YAML::Emitter& out);
+        void write(YAML::Emitter& out);
+        /*
+            Writes only the settings that affect the imported & exported resource, which key the import cache. Packing settings
+            (eg. the pack group) are left out, so changing them does not force a re-import.
+        */
+        virtual void write_import_settings(YAML::Emitter& out);
         virtual void read(const YAML::Node& settings_root_node);
 
         virtual void import_asset(const fs::path& asset_filename) = 0;
+        /* Writes the imported resource out in its runtime binary format. Returns false if there is nothing to export. */
+        virtual bool export_resource(const fs::path& filename) = 0;
 
+#ifndef MILL_HEADLESS
         virtual void render();
+#endif
 
         /* Getters */
 
         auto get_name() const -> const std::string&;
         auto get_resource_id() const -> u64;
+        virtual auto get_resource_type() const -> ResourceTypeId = 0;
+        /* Codec the exported resource is compressed with in its data bank. */
+        virtual auto get_compression_codec() const -> CompressionCodec;
         auto get_resource_flags() const -> ResourceFlags;
+        /* Resources in the same pack group are packed into the same data banks. Empty for the common group. */
+        auto get_pack_group() const -> const std::string&;
         auto get_resource() -> const Shared<Resource>&;
+        /* The exported resource in the import cache. Empty if the asset was imported without the cache. */
+        auto get_cached_filename() const -> const fs::path&;
+
+        void set_cached_filename(const fs::path& filename);
 
         /* Operators */
 
@@ -42,8 +60,10 @@ namespace mill::asset_browser
         std::string m_name{};
         u64 m_resourceId{};  // The exported resource id
         ResourceFlags m_resourceFlags{};
+        std::string m_packGroup{};
 
-        Shared<Resource> m_resource{ nullptr };
+        Shared<Resource> m_resource{ nullptr };  // Not imported if the export was found in the import cache
+        fs::path m_cachedFilename{};
     };
 
     auto create_asset_settings(AssetType type) -> Shared<ExportSettings>;
@@ -0,0 +1,295 @@
+#include "asset_import_cache.hpp"
+
+#include "asset_export_settings.hpp"
+
+#include <mill/io/binary_writer.hpp>
+#include <mill/io/memory_reader.hpp>
+#include <mill/io/mapped_file.hpp>
+#include <mill/resources/resource_factory.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <array>
+#include <format>
+#include <fstream>
+#include <string_view>
+
+namespace mill::asset_browser
+{
+    constexpr auto* g_SourceHashesFilename = "source_hashes.bin";
+    constexpr u32 g_SourceHashesMagic = 0x6873616D;  // "mash"
+
+    namespace
+    {
+        constexpr u64 g_FnvOffsetBasis = 14695981039346656037ull;
+        constexpr u64 g_FnvPrime = 1099511628211ull;
+
+        /* 64-bit FNV-1a. Stable across builds, unlike std::hash, so hashes can be stored. */
+        auto hash_bytes(u64 hash, std::span<const std::byte> bytes) -> u64
+        {
+            for (const auto byte : bytes)
+            {
+                hash ^= static_cast<u64>(byte);
+                hash *= g_FnvPrime;
+            }
+            return hash;
+        }
+
+        template <typename T>
+        auto hash_value(u64 hash, const T& value) -> u64
+        {
+            return hash_bytes(hash, std::as_bytes(std::span(&value, 1)));
+        }
+
+        /* Returns 0 if the file could not be read. */
+        auto hash_file(const std::filesystem::path& filename) -> u64
+        {
+            std::ifstream file(filename, std::ios::binary);
+            if (!file)
+            {
+                return 0;
+            }
+
+            u64 hash = g_FnvOffsetBasis;
+            std::array<char, 64 * 1024> buffer{};
+            while (file)
+            {
+                file.read(buffer.data(), buffer.size());
+                hash = hash_bytes(hash, std::as_bytes(std::span(buffer).first(static_cast<sizet>(file.gcount()))));
+            }
+            return file.eof() ? hash : 0;
+        }
+    }
+
+    AssetImportCache::~AssetImportCache()
+    {
+        close();
+    }
+
+    void AssetImportCache::open(const std::filesystem::path& cache_dir)
+    {
+        close();
+
+        std::error_code error{};
+        std::filesystem::create_directories(cache_dir, error);
+        if (error)
+        {
+            LOG_ERROR("AssetBrowser - AssetImportCache - Failed to create cache directory <{}>: {}", cache_dir.string(), error.message());
+            return;
+        }
+
+        m_cacheDir = cache_dir;
+        load_source_hashes();
+        reset_stats();
+
+        LOG_INFO("AssetBrowser - AssetImportCache - Opened <{}> ({} known source files).", m_cacheDir.string(), m_sourceHashes.size());
+    }
+
+    void AssetImportCache::save()
+    {
+        if (!is_open() || !m_sourceHashesChanged)
+        {
+            return;
+        }
+
+        BinaryWriter writer(m_cacheDir / g_SourceHashesFilename);
+        writer.write_u32(g_SourceHashesMagic);
+        writer.write_u32(g_AssetImportCacheVersion);
+        writer.write_u64(m_sourceHashes.size());
+        for (const auto& [filename, source_hash] : m_sourceHashes)
+        {
+            writer.write(filename);
+            writer.write_u64(source_hash.size);
+            writer.write_i64(source_hash.writeTime);
+            writer.write_u64(source_hash.hash);
+        }
+
+        m_sourceHashesChanged = false;
+    }
+
+    void AssetImportCache::close()
+    {
+        save();
+
+        m_cacheDir.clear();
+        m_sourceHashes.clear();
+        m_sourceHashesChanged = false;
+    }
+
+    bool AssetImportCache::import_asset(const std::filesystem::path& asset_filename, ExportSettings& settings)
+    {
+        const auto key = is_open() ? get_key(asset_filename, settings) : 0;
+        const auto cached_filename = key != 0 ? get_cached_filename(key) : std::filesystem::path{};
+        if (!cached_filename.empty() && std::filesystem::exists(cached_filename))
+        {
+            settings.set_cached_filename(cached_filename);
+
+            std::lock_guard lock(m_mutex);
+            ++m_stats.hitCount;
+            return true;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_stats.missCount;
+        }
+
+        settings.set_cached_filename({});
+        settings.import_asset(asset_filename);
+        if (settings.get_resource() == nullptr)
+        {
+            return false;
+        }
+        if (cached_filename.empty())
+        {
+            return true;
+        }
+
+        // Export next to the entry and then rename it, so an interrupted export never leaves a partial entry behind.
+        // Keys include the resource id, so no other thread is writing the same entry.
+        auto temp_filename = cached_filename;
+        temp_filename += ".tmp";
+        if (!settings.export_resource(temp_filename))
+        {
+            return true;
+        }
+
+        std::error_code error{};
+        std::filesystem::rename(temp_filename, cached_filename, error);
+        if (error)
+        {
+            LOG_WARN("AssetBrowser - AssetImportCache - Failed to add <{}> to the cache: {}", asset_filename.string(), error.message());
+            std::filesystem::remove(temp_filename, error);
+            return true;
+        }
+
+        settings.set_cached_filename(cached_filename);
+        return true;
+    }
+
+    void AssetImportCache::reset_stats()
+    {
+        std::lock_guard lock(m_mutex);
+        m_stats = {};
+    }
+
+    bool AssetImportCache::is_open() const
+    {
+        return !m_cacheDir.empty();
+    }
+
+    auto AssetImportCache::get_stats() const -> AssetImportCacheStats
+    {
+        std::lock_guard lock(m_mutex);
+        return m_stats;
+    }
+
+    auto AssetImportCache::get_key(const std::filesystem::path& asset_filename, ExportSettings& settings) -> u64
+    {
+        const auto source_hash = get_source_hash(asset_filename);
+        if (source_hash == 0)
+        {
+            return 0;
+        }
+
+        // Everything that affects the export is serialised by the settings, including the resource id written into it
+        YAML::Emitter out{};
+        out << YAML::BeginMap;
+        settings.write_import_settings(out);
+        out << YAML::EndMap;
+        const std::string_view settings_str(out.c_str(), out.size());
+
+        u64 key = g_FnvOffsetBasis;
+        key = hash_value(key, g_AssetImportCacheVersion);
+        key = hash_value(key, g_StaticMeshFormatVersion);
+        key = hash_value(key, source_hash);
+        key = hash_bytes(key, std::as_bytes(std::span(settings_str)));
+        return key;
+    }
+
+    auto AssetImportCache::get_source_hash(const std::filesystem::path& filename) -> u64
+    {
+        std::error_code size_error{};
+        std::error_code time_error{};
+        const auto size = std::filesystem::file_size(filename, size_error);
+        const auto write_time = std::filesystem::last_write_time(filename, time_error);
+        if (size_error || time_error)
+        {
+            return 0;
+        }
+
+        const auto key = filename.lexically_normal().generic_string();
+        const auto write_time_count = static_cast<i64>(write_time.time_since_epoch().count());
+
+        {
+            std::lock_guard lock(m_mutex);
+            const auto it = m_sourceHashes.find(key);
+            if (it != m_sourceHashes.end() && it->second.hash != 0 && it->second.size == size && it->second.writeTime == write_time_count)
+            {
+                return it->second.hash;
+            }
+        }
+
+        // Hashed without holding the lock, as it reads the whole file
+        const SourceHash source_hash{ size, write_time_count, hash_file(filename) };
+
+        std::lock_guard lock(m_mutex);
+        m_sourceHashes[key] = source_hash;
+        m_sourceHashesChanged = true;
+        ++m_stats.hashedCount;
+        return source_hash.hash;
+    }
+
+    auto AssetImportCache::get_cached_filename(u64 key) const -> std::filesystem::path
+    {
+        return m_cacheDir / std::format("{:016x}.bin", key);
+    }
+
+    void AssetImportCache::load_source_hashes()
+    {
+        m_sourceHashes.clear();
+        m_sourceHashesChanged = false;
+
+        const auto filename = m_cacheDir / g_SourceHashesFilename;
+        if (!std::filesystem::exists(filename))
+        {
+            return;
+        }
+
+        // Only mapped while reading, so save() can overwrite it
+        MappedFile file(filename);
+        if (!file.is_open())
+        {
+            return;
+        }
+
+        MemoryReader reader(file.get_data());
+        const auto magic = reader.read_u32();
+        const auto version = reader.read_u32();
+        if (reader.has_overrun() || magic != g_SourceHashesMagic || version != g_AssetImportCacheVersion)
+        {
+            LOG_WARN("AssetBrowser - AssetImportCache - Ignoring out of date source hashes <{}>.", filename.string());
+            return;
+        }
+
+        const auto count = reader.read_u64();
+        m_sourceHashes.reserve(count);
+        for (u64 i = 0; i < count && !reader.has_overrun(); ++i)
+        {
+            auto source_filename = reader.read_str();
+
+            SourceHash source_hash{};
+            source_hash.size = reader.read_u64();
+            source_hash.writeTime = reader.read_i64();
+            source_hash.hash = reader.read_u64();
+            m_sourceHashes.emplace(std::move(source_filename), source_hash);
+        }
+
+        if (reader.has_overrun())
+        {
+            LOG_WARN("AssetBrowser - AssetImportCache - Source hashes <{}> are truncated. Ignoring them.", filename.string());
+            m_sourceHashes.clear();
+        }
+    }
+
+}
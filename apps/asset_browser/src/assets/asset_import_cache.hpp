@@ -0,0 +1,80 @@
+#pragma once
+
+#include <mill/mill.hpp>
+
+#include <mutex>
+#include <string>
+#include <filesystem>
+#include <unordered_map>
+
+namespace mill::asset_browser
+{
+    class ExportSettings;
+
+    /* Bump whenever importing or exporting an unchanged asset would produce different data, so stale cache entries are ignored. */
+    constexpr u32 g_AssetImportCacheVersion = 3;
+
+    struct AssetImportCacheStats
+    {
+        u32 hitCount{};
+        u32 missCount{};
+        u32 hashedCount{};  // Source files whose contents had to be (re-)hashed, because they are new or have changed on disk
+    };
+
+    /*
+        Derived data cache of exported resources, so opening a project only re-imports the assets that have changed.
+        Entries are keyed by a hash of the source files contents and the export settings. Source file hashes are remembered by
+        size & write time, so unchanged files are not re-read either.
+        import_asset() is thread-safe, so assets can be imported in parallel. Opening, saving & closing must be done while idle.
+    */
+    class AssetImportCache
+    {
+    public:
+        explicit AssetImportCache() = default;
+        ~AssetImportCache();
+
+        DISABLE_COPY_AND_MOVE(AssetImportCache);
+
+        void open(const std::filesystem::path& cache_dir);
+        /* Writes the source file hashes, if any have changed. */
+        void save();
+        void close();
+
+        /*
+            Points `settings` at its cached export if there is one. Otherwise, imports the asset (eg. through Assimp) and adds its
+            export to the cache. Returns false if the asset could not be imported.
+        */
+        bool import_asset(const std::filesystem::path& asset_filename, ExportSettings& settings);
+
+        void reset_stats();
+
+        /* Getters */
+
+        bool is_open() const;
+        auto get_stats() const -> AssetImportCacheStats;
+
+    private:
+        /* Returns 0 if the source file could not be read. */
+        auto get_key(const std::filesystem::path& asset_filename, ExportSettings& settings) -> u64;
+        auto get_source_hash(const std::filesystem::path& filename) -> u64;
+        auto get_cached_filename(u64 key) const -> std::filesystem::path;
+
+        void load_source_hashes();
+
+    private:
+        struct SourceHash
+        {
+            u64 size{};
+            i64 writeTime{};
+            u64 hash{};
+        };
+
+        std::filesystem::path m_cacheDir{};
+
+        mutable std::mutex m_mutex{};  // Guards the source hashes & stats
+        std::unordered_map<std::string, SourceHash> m_sourceHashes{};  // By source filename
+        bool m_sourceHashesChanged{ false };
+
+        AssetImportCacheStats m_stats{};
+    };
+}
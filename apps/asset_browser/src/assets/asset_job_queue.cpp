@@ -0,0 +1,158 @@
+#include "asset_job_queue.hpp"
+
+#include <exception>
+#include <algorithm>
+
+namespace mill::asset_browser
+{
+    AssetJobQueue::AssetJobQueue(u32 thread_count)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        m_threads.reserve(thread_count);
+        for (u32 i = 0; i < thread_count; ++i)
+        {
+            m_threads.emplace_back([this] { worker_thread_func(); });
+        }
+    }
+
+    AssetJobQueue::~AssetJobQueue()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopThreads = true;
+        }
+        m_jobCondition.notify_all();
+
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    auto AssetJobQueue::add_job(const std::string& name, JobFunc func) -> u32
+    {
+        ASSERT(func != nullptr);
+
+        u32 index{};
+        {
+            std::lock_guard lock(m_mutex);
+            index = CAST_U32(m_progress.size());
+            m_jobFuncs.push_back(std::move(func));
+            m_progress.push_back({ name });
+            m_queuedJobs.push_back(index);
+        }
+        m_jobCondition.notify_one();
+        return index;
+    }
+
+    void AssetJobQueue::wait()
+    {
+        std::unique_lock lock(m_mutex);
+        m_idleCondition.wait(lock, [this] { return m_queuedJobs.empty() && m_runningCount == 0; });
+    }
+
+    void AssetJobQueue::clear()
+    {
+        std::lock_guard lock(m_mutex);
+        ASSERT(m_queuedJobs.empty() && m_runningCount == 0);
+
+        m_jobFuncs.clear();
+        m_progress.clear();
+        m_finishedCount = 0;
+        m_failedCount = 0;
+    }
+
+    bool AssetJobQueue::is_idle() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_queuedJobs.empty() && m_runningCount == 0;
+    }
+
+    auto AssetJobQueue::get_thread_count() const -> u32
+    {
+        return CAST_U32(m_threads.size());
+    }
+
+    auto AssetJobQueue::get_job_count() const -> u32
+    {
+        std::lock_guard lock(m_mutex);
+        return CAST_U32(m_progress.size());
+    }
+
+    auto AssetJobQueue::get_finished_count() const -> u32
+    {
+        std::lock_guard lock(m_mutex);
+        return m_finishedCount;
+    }
+
+    auto AssetJobQueue::get_failed_count() const -> u32
+    {
+        std::lock_guard lock(m_mutex);
+        return m_failedCount;
+    }
+
+    auto AssetJobQueue::get_progress() const -> std::vector<AssetJobProgress>
+    {
+        std::lock_guard lock(m_mutex);
+        return m_progress;
+    }
+
+    void AssetJobQueue::worker_thread_func()
+    {
+        while (true)
+        {
+            u32 index{};
+            JobFunc func{};
+            {
+                std::unique_lock lock(m_mutex);
+                m_jobCondition.wait(lock, [this] { return m_stopThreads || !m_queuedJobs.empty(); });
+                if (m_stopThreads)
+                {
+                    return;
+                }
+
+                index = m_queuedJobs.front();
+                m_queuedJobs.pop_front();
+                func = std::move(m_jobFuncs[index]);
+                m_progress[index].state = AssetJobState::eRunning;
+                ++m_runningCount;
+            }
+
+            const auto start_time = Clock::now();
+            bool succeeded = false;
+            try
+            {
+                succeeded = func();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("AssetBrowser - AssetJobQueue - Job threw an exception: {}", e.what());
+            }
+            const std::chrono::duration<f64, std::milli> duration = Clock::now() - start_time;
+
+            {
+                std::lock_guard lock(m_mutex);
+                auto& progress = m_progress[index];
+                progress.state = succeeded ? AssetJobState::eSucceeded : AssetJobState::eFailed;
+                progress.durationMs = duration.count();
+                if (!succeeded)
+                {
+                    LOG_ERROR("AssetBrowser - AssetJobQueue - Job <{}> failed.", progress.name);
+                    ++m_failedCount;
+                }
+
+                ++m_finishedCount;
+                --m_runningCount;
+                if (m_queuedJobs.empty() && m_runningCount == 0)
+                {
+                    m_idleCondition.notify_all();
+                }
+            }
+        }
+    }
+
+}
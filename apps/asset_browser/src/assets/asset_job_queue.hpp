@@ -0,0 +1,82 @@
+#pragma once
+
+#include <mill/mill.hpp>
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+namespace mill::asset_browser
+{
+    enum class AssetJobState : u8
+    {
+        eQueued,
+        eRunning,
+        eSucceeded,
+        eFailed,
+    };
+
+    struct AssetJobProgress
+    {
+        std::string name{};
+        AssetJobState state{ AssetJobState::eQueued };
+        f64 durationMs{};  // Only set once the job has finished
+    };
+
+    /*
+        Runs asset jobs (eg. importing or exporting an asset) on a pool of worker threads, tracking the progress of each job.
+        Jobs must not touch the RHI or the ImGui context, which are main thread only.
+    */
+    class AssetJobQueue
+    {
+    public:
+        /* Returns true if the job succeeded. Exceptions thrown by a job are caught and count as a failure. */
+        using JobFunc = std::function<bool()>;
+
+        /* A `thread_count` of 0 uses a thread per hardware thread. */
+        explicit AssetJobQueue(u32 thread_count = 0);
+        ~AssetJobQueue();
+
+        DISABLE_COPY_AND_MOVE(AssetJobQueue);
+
+        /* Returns the index of the jobs progress in get_progress(). */
+        auto add_job(const std::string& name, JobFunc func) -> u32;
+        /* Blocks until every job added so far has finished. */
+        void wait();
+        /* Forgets every finished job. Must only be called once idle. */
+        void clear();
+
+        /* Getters */
+
+        bool is_idle() const;
+        auto get_thread_count() const -> u32;
+        auto get_job_count() const -> u32;
+        auto get_finished_count() const -> u32;
+        auto get_failed_count() const -> u32;
+        auto get_progress() const -> std::vector<AssetJobProgress>;
+
+    private:
+        void worker_thread_func();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        mutable std::mutex m_mutex{};
+        std::condition_variable m_jobCondition{};
+        std::condition_variable m_idleCondition{};
+        std::vector<std::thread> m_threads{};
+        bool m_stopThreads{ false };
+
+        std::deque<u32> m_queuedJobs{};  // Indices into `m_jobFuncs` & `m_progress`
+        std::vector<JobFunc> m_jobFuncs{};
+        std::vector<AssetJobProgress> m_progress{};
+        u32 m_runningCount{};
+        u32 m_finishedCount{};
+        u32 m_failedCount{};
+    };
+}
@@ -2,20 +2,24 @@
 
 #include "asset_type.hpp"
 #include "asset_export_settings.hpp"
+#include "asset_import_cache.hpp"
 
 #include <yaml-cpp/yaml.h>
 
 #include <string>
+#include <algorithm>
 #include <string_view>
 #include <unordered_map>
 #include <fstream>
 
 namespace mill::asset_browser
 {
-    void AssetMetadata::import_asset()
+    bool AssetMetadata::import_asset(AssetImportCache& import_cache)
     {
+        bool imported = true;
         for (auto& settings : exportSettings)
-            settings->import_asset(assetFilename);
+            imported &= import_cache.import_asset(assetFilename, *settings);
+        return imported;
     }
 
     void AssetMetadata::to_file(const AssetMetadata& metadata, const std::filesystem::path& filename)
@@ -80,9 +84,34 @@ namespace mill::asset_browser
             }
         }
 
-        metadata.import_asset();
-
         return metadata;
     }
 
+    auto scan_for_asset_metadata(const std::filesystem::path& dir) -> std::vector<AssetMetadata>
+    {
+        LOG_INFO("AssetBrowser - Scanning for assets in directory <{}>.", dir.string());
+
+        std::vector<AssetMetadata> assets{};
+        for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(dir))
+        {
+            if (!dir_entry.is_regular_file())
+                continue;
+
+            const auto& file_path = dir_entry.path();
+            const bool is_metadata_file = file_path.filename().string().ends_with(".meta");
+            if (!is_metadata_file)
+                continue;
+
+            LOG_DEBUG("AssetBrowser - Found asset metadata: {}.", file_path.string());
+
+            auto metadata = AssetMetadata::from_file(file_path);
+            if (metadata.id)
+                assets.push_back(std::move(metadata));
+        }
+
+        // Directory iteration order is unspecified, so sort to keep everything downstream deterministic
+        std::sort(assets.begin(), assets.end(), [](const auto& lhs, const auto& rhs) { return lhs.assetFilename < rhs.assetFilename; });
+        return assets;
+    }
+
 }
@@ -11,6 +11,8 @@
 
 namespace mill::asset_browser
 {
+    class AssetImportCache;
+
     struct AssetMetadata
     {
         u64 id{};
@@ -21,9 +23,16 @@ namespace mill::asset_browser
 
         std::vector<Shared<ExportSettings>> exportSettings{};
 
-        void import_asset();
+        /*
+            Imports the asset for each of its export settings, unless their export is already in `import_cache`.
+            Returns false if any failed to import. Thread-safe, as long as each asset is only imported by one thread at a time.
+        */
+        bool import_asset(AssetImportCache& import_cache);
 
         static void to_file(const AssetMetadata& metadata, const std::filesystem::path& filename);
         static auto from_file(const std::filesystem::path& filename) -> AssetMetadata;
     };
+
+    /* Reads every asset metadata (.meta) file in `dir` and its sub-directories, without importing the assets. */
+    auto scan_for_asset_metadata(const std::filesystem::path& dir) -> std::vector<AssetMetadata>;
 }
\ No newline at end of file
@@ -58,4 +58,9 @@ namespace mill::asset_browser
         return it->second;
     }
 
+    auto AssetRegistry::get_all_metadata() const -> const std::unordered_map<u64, AssetMetadata>&
+    {
+        return m_metadataMap;
+    }
+
 }
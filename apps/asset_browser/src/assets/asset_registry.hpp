@@ -20,6 +20,7 @@ namespace mill::asset_browser
         auto get_metadata_ref(u64 asset_id) -> AssetMetadata&;
 
         auto get_asset_id(const std::filesystem::path asset_path) const -> u64;
+        auto get_all_metadata() const -> const std::unordered_map<u64, AssetMetadata>&;
 
     private:
         std::unordered_map<u64, AssetMetadata> m_metadataMap{};
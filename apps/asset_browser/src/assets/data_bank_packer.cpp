@@ -0,0 +1,219 @@
+#include "data_bank_packer.hpp"
+
+#include <map>
+#include <array>
+#include <cctype>
+#include <vector>
+#include <format>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <unordered_set>
+
+namespace mill::asset_browser
+{
+    namespace
+    {
+        constexpr u64 g_ResourceAlignment = 16;  // Keeps the blocks within a resource (eg. g_StaticMeshBlockAlignment) aligned in memory
+        constexpr auto* g_CommonGroupName = "common";
+
+        /* Returns where a resource of `size` bytes goes in a bank that currently ends at `offset`. */
+        auto get_packed_offset(u64 offset, u64 size) -> u64
+        {
+            if (size >= g_DataBankPageSize)
+            {
+                return align_up(offset, g_DataBankPageSize);
+            }
+
+            offset = align_up(offset, g_ResourceAlignment);
+            const auto page_end = align_up(offset + 1, g_DataBankPageSize);
+            return offset + size > page_end ? page_end : offset;
+        }
+
+        /* Pack groups are user-provided, so only keep characters that are safe in a filename. */
+        auto get_group_filename(const std::string& group) -> std::string
+        {
+            if (group.empty())
+            {
+                return g_CommonGroupName;
+            }
+
+            std::string filename = group;
+            std::replace_if(
+                filename.begin(), filename.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '-'; }, '_');
+            return filename;
+        }
+
+        bool read_file(const std::filesystem::path& filename, std::vector<char>& out_data)
+        {
+            std::ifstream file(filename, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                return false;
+            }
+
+            out_data.resize(static_cast<sizet>(file.tellg()));
+            file.seekg(0);
+            file.read(out_data.data(), static_cast<std::streamsize>(out_data.size()));
+            return static_cast<bool>(file);
+        }
+
+        /* Moves a fully written bank into place, so a running engine never sees (or has mapped) a partially written bank. */
+        bool replace_data_bank(const std::filesystem::path& temp_filename, const std::filesystem::path& filename)
+        {
+            std::error_code error{};
+            std::filesystem::rename(temp_filename, filename, error);
+            if (error)
+            {
+                LOG_ERROR("AssetBrowser - DataBankPacker - Failed to replace data bank <{}>: {}", filename.string(), error.message());
+                std::filesystem::remove(temp_filename, error);
+                return false;
+            }
+            return true;
+        }
+
+        auto get_temp_filename(const std::filesystem::path& filename) -> std::filesystem::path
+        {
+            auto temp_filename = filename;
+            temp_filename += ".tmp";
+            return temp_filename;
+        }
+    }
+
+    bool pack_data_banks(std::span<DataBankPackEntry> entries, const std::filesystem::path& data_dir)
+    {
+        static constexpr std::array<char, g_DataBankPageSize> s_Padding{};
+
+        std::map<std::pair<std::string, ResourceTypeId>, std::vector<DataBankPackEntry*>> groups{};
+        for (auto& entry : entries)
+        {
+            ASSERT(entry.metadata != nullptr);
+            groups[{ get_group_filename(entry.group), entry.metadata->typeId }].push_back(&entry);
+        }
+
+        bool success = true;
+        u32 bank_count = 0;
+        u64 total_size = 0;
+        u64 total_padding = 0;
+        std::vector<char> data{};
+        for (auto& [key, group_entries] : groups)
+        {
+            const auto& [group_name, type_id] = key;
+
+            // Deterministic order, so re-baking unchanged assets produces identical banks
+            std::sort(group_entries.begin(),
+                      group_entries.end(),
+                      [](const DataBankPackEntry* lhs, const DataBankPackEntry* rhs) { return lhs->metadata->id < rhs->metadata->id; });
+
+            std::ofstream bank_file{};
+            std::string bank_filename{};
+            u64 bank_size = 0;
+            u32 bank_index = 0;
+            const auto finish_bank = [&]
+            {
+                if (!bank_file.is_open())
+                {
+                    return true;
+                }
+                bank_file.close();
+                return replace_data_bank(get_temp_filename(data_dir / bank_filename), data_dir / bank_filename);
+            };
+            for (auto* entry : group_entries)
+            {
+                auto& metadata = *entry->metadata;
+                if (!read_file(entry->sourceFilename, data) || data.size() != metadata.binarySize)
+                {
+                    LOG_ERROR("AssetBrowser - DataBankPacker - Failed to read resource <{}> from <{}>.",
+                              metadata.id,
+                              entry->sourceFilename.string());
+                    success = false;
+                    continue;
+                }
+
+                auto offset = get_packed_offset(bank_size, data.size());
+                if (!bank_file.is_open() || (bank_size != 0 && offset + data.size() > g_MaxDataBankSize))
+                {
+                    if (!finish_bank())
+                    {
+                        return false;
+                    }
+                    bank_filename = std::format("{}_{}_{}{}", group_name, type_id, bank_index++, g_DataBankExt);
+                    bank_file.open(get_temp_filename(data_dir / bank_filename), std::ios::binary | std::ios::trunc);
+                    if (!bank_file)
+                    {
+                        LOG_ERROR("AssetBrowser - DataBankPacker - Failed to open data bank <{}>.", (data_dir / bank_filename).string());
+                        return false;
+                    }
+
+                    ++bank_count;
+                    total_size += bank_size;
+                    bank_size = 0;
+                    offset = 0;
+                }
+
+                const auto padding = offset - bank_size;
+                ASSERT(padding <= s_Padding.size());
+                bank_file.write(s_Padding.data(), static_cast<std::streamsize>(padding));
+                bank_file.write(data.data(), static_cast<std::streamsize>(data.size()));
+                if (!bank_file)
+                {
+                    LOG_ERROR("AssetBrowser - DataBankPacker - Failed to write to data bank <{}>.", (data_dir / bank_filename).string());
+                    bank_file.close();
+                    std::error_code error{};
+                    std::filesystem::remove(get_temp_filename(data_dir / bank_filename), error);
+                    return false;
+                }
+
+                metadata.binaryFile = bank_filename;
+                metadata.binaryOffset = offset;
+                bank_size = offset + data.size();
+                total_padding += padding;
+            }
+            if (!finish_bank())
+            {
+                return false;
+            }
+            total_size += bank_size;
+        }
+
+        LOG_INFO("AssetBrowser - DataBankPacker - Packed {} resources into {} data banks ({}B, {}B of alignment padding).",
+                 entries.size(),
+                 bank_count,
+                 total_size,
+                 total_padding);
+        return success;
+    }
+
+    void remove_stale_data_banks(std::span<const ResourceMetadata> resources, const std::filesystem::path& data_dir)
+    {
+        std::unordered_set<std::string> bank_filenames{};
+        for (const auto& metadata : resources)
+        {
+            bank_filenames.insert(metadata.binaryFile);
+        }
+
+        std::vector<std::filesystem::path> stale_filenames{};
+        for (const auto& dir_entry : std::filesystem::directory_iterator(data_dir))
+        {
+            const auto& filename = dir_entry.path();
+            const bool is_data_bank = dir_entry.is_regular_file() && filename.extension() == g_DataBankExt;
+            if (is_data_bank && !bank_filenames.contains(filename.filename().string()))
+            {
+                stale_filenames.push_back(filename);
+            }
+        }
+
+        for (const auto& filename : stale_filenames)
+        {
+            std::error_code error{};
+            std::filesystem::remove(filename, error);
+            if (error)
+            {
+                LOG_WARN("AssetBrowser - DataBankPacker - Failed to remove stale data bank <{}>: {}", filename.string(), error.message());
+            }
+        }
+
+        LOG_INFO("AssetBrowser - DataBankPacker - Removed {} stale data banks.", stale_filenames.size());
+    }
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <mill/mill.hpp>
+
+#include <span>
+#include <string>
+#include <filesystem>
+
+namespace mill::asset_browser
+{
+    constexpr u64 g_DataBankPageSize = 4096;
+    constexpr u64 g_MaxDataBankSize = 256ull * 1024 * 1024;  // Groups larger than this are split across several banks
+    constexpr auto* g_DataBankExt = ".bin";
+
+    struct DataBankPackEntry
+    {
+        ResourceMetadata* metadata{ nullptr };  // Pointed at its packed location once packed
+        std::filesystem::path sourceFilename{};  // The resource exported on its own
+        std::string group{};                     // Resources expected to be loaded together, eg. a level. Empty for the common group.
+    };
+
+    /*
+        Packs individually exported resources into a small number of data banks in `data_dir`, so the runtime maps few files and reads
+        each one front-to-back. Resources get a bank per pack group & resource type, split every `g_MaxDataBankSize` bytes.
+        Within a bank, resources never straddle more pages than their size requires: resources of a page or more start on a page
+        boundary, and smaller resources are moved to the next page rather than split across two.
+        Each bank is written to a temporary file and renamed into place once complete, so a running engine can hot reload it.
+        Returns false if any bank could not be written.
+    */
+    bool pack_data_banks(std::span<DataBankPackEntry> entries, const std::filesystem::path& data_dir);
+
+    /*
+        Deletes the data banks in `data_dir` that none of `resources` are packed into, left over from earlier packs.
+        Call once the metadata pointing at the new banks has been written, so a running engine never loses a bank it still uses.
+    */
+    void remove_stale_data_banks(std::span<const ResourceMetadata> resources, const std::filesystem::path& data_dir);
+}
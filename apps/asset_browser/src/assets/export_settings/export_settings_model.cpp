@@ -1,10 +1,16 @@
 #include "export_settings_model.hpp"
 
 #include "../mesh_importer.hpp"
+#include "../mesh_exporter.hpp"
 
 #include <mill/mill.hpp>
 
+#include <format>
+#include <algorithm>
+
+#ifndef MILL_HEADLESS
 #include <imgui.h>
+#endif
 
 namespace mill::asset_browser
 {
@@ -22,12 +28,17 @@ namespace mill::asset_browser
         }
     }
 
-    void ExportSettingsModel::write(YAML::Emitter& out)
+    void ExportSettingsModel::write_import_settings(YAML::Emitter& out)
     {
-        ExportSettings::write(out);
+        ExportSettings::write_import_settings(out);
 
         out << YAML::Key << "mesh_type" << YAML::Key << static_cast<i32>(m_type);
         out << YAML::Key << "lod_count" << YAML::Key << m_lodCount;
+        out << YAML::Key << "lod_ratios" << YAML::Value << YAML::Flow << m_lodRatios;
+        out << YAML::Key << "optimize" << YAML::Key << m_optimize;
+        out << YAML::Key << "split_for_u16_indices" << YAML::Key << m_splitForU16Indices;
+        out << YAML::Key << "quantize_vertices" << YAML::Key << m_quantizeVertices;
+        out << YAML::Key << "split_position_stream" << YAML::Key << m_splitPositionStream;
     }
 
     void ExportSettingsModel::read(const YAML::Node& settings_root_node)
@@ -38,22 +49,98 @@ namespace mill::asset_browser
             m_type = static_cast<MeshType>(settings_root_node["mesh_type"].as<i32>());
         if (settings_root_node["lod_count"])
             m_lodCount = settings_root_node["lod_count"].as<u32>();
+        if (settings_root_node["lod_ratios"])
+            m_lodRatios = settings_root_node["lod_ratios"].as<std::vector<f32>>();
+        if (settings_root_node["optimize"])
+            m_optimize = settings_root_node["optimize"].as<bool>();
+        if (settings_root_node["split_for_u16_indices"])
+            m_splitForU16Indices = settings_root_node["split_for_u16_indices"].as<bool>();
+        if (settings_root_node["quantize_vertices"])
+            m_quantizeVertices = settings_root_node["quantize_vertices"].as<bool>();
+        if (settings_root_node["split_position_stream"])
+            m_splitPositionStream = settings_root_node["split_position_stream"].as<bool>();
+
+        resize_lod_ratios();
     }
 
     void ExportSettingsModel::import_asset(const fs::path& asset_filename)
     {
         if (m_type == MeshType::eStatic)
-            set_resource(import_static_mesh(asset_filename.string()));
+        {
+            const StaticMeshImportOptions options{
+                .optimize = m_optimize,
+                .splitForU16Indices = m_splitForU16Indices,
+                .lodRatios = m_lodRatios,
+            };
+            set_resource(import_static_mesh(asset_filename.string(), options));
+        }
 
         // #TODO: Import skeletal mesh
     }
 
+    bool ExportSettingsModel::export_resource(const fs::path& filename)
+    {
+        if (m_type == MeshType::eStatic)
+        {
+            auto* static_mesh = static_cast<StaticMesh*>(get_resource().get());
+            if (static_mesh == nullptr)
+                return false;
+
+            const StaticMeshExportOptions options{
+                .quantizeVertices = m_quantizeVertices,
+                .splitPositionStream = m_splitPositionStream,
+            };
+            export_static_mesh(*static_mesh, get_resource_id(), filename.string(), options);
+            return true;
+        }
+
+        // #TODO: Export skeletal mesh
+        return false;
+    }
+
+    auto ExportSettingsModel::get_resource_type() const -> ResourceTypeId
+    {
+        // Only static meshes are exported so far (see export_resource()), so no other type is ever baked
+        ASSERT(m_type == MeshType::eStatic);
+        return get_resource_type_id<StaticMesh>();
+    }
+
+    auto ExportSettingsModel::get_compression_codec() const -> CompressionCodec
+    {
+        // Meshes are large and loaded often, so favour decompression speed
+        return CompressionCodec::eLZ4;
+    }
+
+#ifndef MILL_HEADLESS
     void ExportSettingsModel::render()
     {
         ExportSettings::render();
 
         ImGui::Combo("Mesh Type", reinterpret_cast<i32*>(&m_type), "Static\0Skeletal\0\0");
-        ImGui::DragInt("Lod Count", reinterpret_cast<i32*>(&m_lodCount), 1.0f, 1, 10);
+        if (ImGui::DragInt("Lod Count", reinterpret_cast<i32*>(&m_lodCount), 1.0f, 1, 10))
+            resize_lod_ratios();
+        for (sizet i = 0; i < m_lodRatios.size(); ++i)
+        {
+            const auto label = std::format("Lod {} Triangle Ratio", i + 1);
+            ImGui::DragFloat(label.c_str(), &m_lodRatios[i], 0.01f, 0.01f, 1.0f);
+        }
+        ImGui::Checkbox("Optimize", &m_optimize);
+        ImGui::Checkbox("Split For 16-bit Indices", &m_splitForU16Indices);
+        ImGui::Checkbox("Quantize Vertices", &m_quantizeVertices);
+        ImGui::Checkbox("Separate Position Stream", &m_splitPositionStream);
+    }
+#endif
+
+    void ExportSettingsModel::resize_lod_ratios()
+    {
+        m_lodCount = std::max(m_lodCount, 1u);
+
+        const auto previous_size = m_lodRatios.size();
+        m_lodRatios.resize(m_lodCount - 1);
+        for (sizet i = previous_size; i < m_lodRatios.size(); ++i)
+        {
+            m_lodRatios[i] = (i == 0 ? 1.0f : m_lodRatios[i - 1]) * 0.5f;
+        }
     }
 
 }
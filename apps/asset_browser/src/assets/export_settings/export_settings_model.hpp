@@ -6,6 +6,8 @@
 
 #include <yaml-cpp/yaml.h>
 
+#include <vector>
+
 namespace mill::asset_browser
 {
     enum class MeshType : u8
@@ -17,15 +19,30 @@ namespace mill::asset_browser
     class ExportSettingsModel : public ExportSettings
     {
     public:
-        void write(YAML::Emitter& out) override;
+        void write_import_settings(YAML::Emitter& out) override;
         void read(const YAML::Node& settings_root_node) override;
 
         void import_asset(const fs::path& asset_filename) override;
+        bool export_resource(const fs::path& filename) override;
+
+        auto get_resource_type() const -> ResourceTypeId override;
+        auto get_compression_codec() const -> CompressionCodec override;
 
+#ifndef MILL_HEADLESS
         void render() override;
+#endif
+
+    private:
+        /* Keeps a ratio for each LOD after the first, defaulting new LODs to half the triangles of the previous one. */
+        void resize_lod_ratios();
 
     private:
         MeshType m_type{};
         u32 m_lodCount{ 1 };
+        std::vector<f32> m_lodRatios{};  // Fraction of the triangles kept by each LOD after the first
+        bool m_optimize{ true };  // Reorder triangles & vertices for the GPU's vertex cache, overdraw & vertex fetch
+        bool m_splitForU16Indices{ false };  // Split large submeshes instead of exporting with 32-bit indices
+        bool m_quantizeVertices{ false };    // Export 16 byte quantized vertices instead of 32 byte float ones
+        bool m_splitPositionStream{ false };  // Export positions as a separate stream for position-only passes
     };
 }
\ No newline at end of file
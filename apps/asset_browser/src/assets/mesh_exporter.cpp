@@ -3,60 +3,200 @@
 #include <mill/mill.hpp>
 #include <mill/resources/resource_factory.hpp>
 
+#include <glm/gtc/packing.hpp>
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
 namespace mill::asset_browser
 {
-    void export_static_mesh(StaticMesh& mesh, const std::string& filename)
+    namespace
+    {
+        void write_padding_to_block_alignment(BinaryWriter& writer, u64& position)
+        {
+            static constexpr std::array<std::byte, g_StaticMeshBlockAlignment> s_Padding{};
+
+            const auto padding_size = align_up(position, g_StaticMeshBlockAlignment) - position;
+            writer.write_bytes(std::span(s_Padding).first(padding_size));
+            position += padding_size;
+        }
+
+        auto quantize_unorm16(f32 value) -> u16
+        {
+            return CAST_U16(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+        }
+
+        auto quantize_unorm8(f32 value) -> u8
+        {
+            return CAST_U8(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+        }
+
+        /*
+            Positions are quantized within the bounds of their submesh, which the renderer scales them back into. Only the first
+            LOD's submeshes are needed, as the other LODs share their vertices & bounds.
+        */
+        auto quantize_vertices(const std::vector<StaticVertex>& vertices, std::span<const StaticMesh::Submesh> submeshes)
+            -> std::vector<QuantizedStaticVertex>
+        {
+            std::vector<QuantizedStaticVertex> quantized_vertices(vertices.size());
+            for (const auto& submesh : submeshes)
+            {
+                const auto extent = submesh.boundsMax - submesh.boundsMin;
+                for (u32 i = submesh.vertexOffset; i < submesh.vertexOffset + submesh.vertexCount; ++i)
+                {
+                    const auto& vertex = vertices[i];
+                    auto& quantized_vertex = quantized_vertices[i];
+                    for (u32 axis = 0; axis < 3; ++axis)
+                    {
+                        // Flat axes have no extent, so every vertex sits on the bounds
+                        const auto normalized = extent[axis] > 0.0f ? (vertex.position[axis] - submesh.boundsMin[axis]) / extent[axis] : 0.0f;
+                        quantized_vertex.position[axis] = quantize_unorm16(normalized);
+                    }
+
+                    quantized_vertex.texCoord[0] = glm::packHalf1x16(vertex.texCoord.x);
+                    quantized_vertex.texCoord[1] = glm::packHalf1x16(vertex.texCoord.y);
+
+                    quantized_vertex.color[0] = quantize_unorm8(vertex.color.x);
+                    quantized_vertex.color[1] = quantize_unorm8(vertex.color.y);
+                    quantized_vertex.color[2] = quantize_unorm8(vertex.color.z);
+                    quantized_vertex.color[3] = 255;
+                }
+            }
+            return quantized_vertices;
+        }
+
+        auto get_position(const StaticVertex& vertex) -> glm::vec3
+        {
+            return vertex.position;
+        }
+
+        auto get_position(const QuantizedStaticVertex& vertex) -> std::array<u16, 4>
+        {
+            return { vertex.position[0], vertex.position[1], vertex.position[2], vertex.position[3] };
+        }
+
+        auto get_attributes(const StaticVertex& vertex) -> StaticVertexAttributes
+        {
+            return { vertex.texCoord, vertex.color };
+        }
+
+        auto get_attributes(const QuantizedStaticVertex& vertex) -> QuantizedStaticVertexAttributes
+        {
+            QuantizedStaticVertexAttributes attributes{};
+            std::copy_n(vertex.texCoord, 2, attributes.texCoord);
+            std::copy_n(vertex.color, 4, attributes.color);
+            return attributes;
+        }
+
+        /* Writes the interleaved vertices, or a position block followed by an attribute block if `split_position_stream`. */
+        template <typename Vertex>
+        void write_vertices(BinaryWriter& writer, u64& position, const std::vector<Vertex>& vertices, bool split_position_stream)
+        {
+            write_padding_to_block_alignment(writer, position);
+            if (!split_position_stream)
+            {
+                writer.write_array(std::span(vertices));
+                position += vec_data_size(vertices);
+                return;
+            }
+
+            std::vector<decltype(get_position(vertices.front()))> positions{};
+            std::vector<decltype(get_attributes(vertices.front()))> attributes{};
+            positions.reserve(vertices.size());
+            attributes.reserve(vertices.size());
+            for (const auto& vertex : vertices)
+            {
+                positions.push_back(get_position(vertex));
+                attributes.push_back(get_attributes(vertex));
+            }
+
+            writer.write_array(std::span(positions));
+            position += vec_data_size(positions);
+
+            write_padding_to_block_alignment(writer, position);
+            writer.write_array(std::span(attributes));
+            position += vec_data_size(attributes);
+        }
+    }
+
+    void export_static_mesh(StaticMesh& mesh, ResourceId resource_id, const std::string& filename, const StaticMeshExportOptions& options)
     {
         BinaryWriter writer(filename);
 
+        const auto& vertices = mesh.get_vertices();
+        const auto& triangles = mesh.get_indices();
+        const auto& submeshes = mesh.get_submeshes();
+        const auto& lods = mesh.get_lods();
+
         // Resource Type Header
         writer.write_u8(g_StaticMeshHeader[0]);
         writer.write_u8(g_StaticMeshHeader[1]);
         writer.write_u8(g_StaticMeshHeader[2]);
 
         // Format version
-        u16 formatVersion = 0;
-        writer.write_u16(formatVersion);
+        writer.write_u16(g_StaticMeshFormatVersion);
 
         // Resource Id
-        const u64 resourceId = 1998;
-        writer.write_u64(resourceId);
+        writer.write_u64(resource_id);
 
-        // Vertices
-        const auto& vertices = mesh.get_vertices();
+        // Counts
         writer.write_u64(vertices.size());
-        for (const auto& vertex : vertices)
-        {
-            writer.write_f32(vertex.position.x);
-            writer.write_f32(vertex.position.y);
-            writer.write_f32(vertex.position.z);
+        writer.write_u64(triangles.size());
+        writer.write_u64(submeshes.size());
 
-            writer.write_f32(vertex.texCoord.x);
-            writer.write_f32(vertex.texCoord.y);
+        // Index size. 16-bit unless a submesh has too many vertices.
+        const auto index_type = StaticMesh::select_index_type(submeshes);
+        const auto index_size = index_type == rhi::IndexType::eU16 ? sizeof(u16) : sizeof(u32);
+        writer.write_u32(CAST_U32(index_size));
 
-            writer.write_f32(vertex.color.x);
-            writer.write_f32(vertex.color.y);
-            writer.write_f32(vertex.color.z);
+        // Vertex format
+        const auto vertex_format = options.quantizeVertices ? StaticVertexFormat::eQuantized : StaticVertexFormat::eFloat;
+        writer.write_u32(static_cast<u32>(vertex_format));
+
+        // Stream layout. 1 if positions are split from the other attributes.
+        writer.write_u32(options.splitPositionStream ? 1 : 0);
+
+        // LOD count
+        writer.write_u32(CAST_U32(lods.size()));
+
+        u64 position = 3 + sizeof(u16) + sizeof(u64) * 4 + sizeof(u32) * 4;
+
+        // Vertices
+        if (vertex_format == StaticVertexFormat::eQuantized)
+        {
+            write_vertices(writer, position, quantize_vertices(vertices, mesh.get_lod_submeshes(0)), options.splitPositionStream);
+        }
+        else
+        {
+            write_vertices(writer, position, vertices, options.splitPositionStream);
         }
 
         // Triangles
-        const auto& triangles = mesh.get_indices();
-        writer.write_u64(triangles.size());
-        for (auto index : triangles)
+        write_padding_to_block_alignment(writer, position);
+        if (index_type == rhi::IndexType::eU16)
+        {
+            const std::vector<u16> narrowed_triangles(triangles.begin(), triangles.end());
+            writer.write_array(std::span(narrowed_triangles));
+        }
+        else
         {
-            writer.write_u16(index);
+            writer.write_array(std::span(triangles));
         }
+        position += triangles.size() * index_size;
 
         // Submeshes
-        const auto& submeshes = mesh.get_submeshes();
-        writer.write_u64(submeshes.size());
-        for (const auto& submesh : submeshes)
+        write_padding_to_block_alignment(writer, position);
+        writer.write_array(std::span(submeshes));
+        position += vec_data_size(submeshes);
+
+        // LODs
+        if (!lods.empty())
         {
-            writer.write_u32(submesh.indexOffset);
-            writer.write_u32(submesh.indexCount);
-            writer.write_u32(submesh.vertexOffset);
-            writer.write_u32(submesh.vertexCount);
-            writer.write_u32(submesh.materialIndex);
+            write_padding_to_block_alignment(writer, position);
+            writer.write_array(std::span(lods));
         }
     }
 
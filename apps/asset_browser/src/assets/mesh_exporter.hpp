@@ -6,5 +6,13 @@
 
 namespace mill::asset_browser
 {
-    void export_static_mesh(StaticMesh& mesh, const std::string& filename);
+    struct StaticMeshExportOptions
+    {
+        bool quantizeVertices{ false };  // Export QuantizedStaticVertex instead of StaticVertex, halving the vertex data
+        // Export positions as their own stream, so position-only passes fetch less. Only pays off once there is a depth
+        // pre-pass or shadow pass; the forward pass binds both streams, so until then it is one more vertex binding per draw.
+        bool splitPositionStream{ false };
+    };
+
+    void export_static_mesh(StaticMesh& mesh, ResourceId resource_id, const std::string& filename, const StaticMeshExportOptions& options = {});
 }
\ No newline at end of file
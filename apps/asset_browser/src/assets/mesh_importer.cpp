@@ -1,16 +1,22 @@
 #include "mesh_importer.hpp"
 
+#include "mesh_optimizer.hpp"
+
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <glm/common.hpp>
+
+#include <span>
+
 namespace mill::asset_browser
 {
     constexpr auto g_StaticMeshImportFlags = aiProcessPreset_TargetRealtime_MaxQuality;
 
     void process_mesh(const aiMesh* mesh,
                       std::vector<StaticVertex>& vertices,
-                      std::vector<u16>& triangles,
+                      std::vector<u32>& triangles,
                       std::vector<StaticMesh::Submesh>& submeshes)
     {
         auto& submesh = submeshes.emplace_back();
@@ -46,21 +52,21 @@ namespace mill::asset_browser
         {
             const auto& face = mesh->mFaces[i];
             ASSERT(face.mNumIndices == 3);
-            triangles.push_back(static_cast<u16>(face.mIndices[0]));
-            triangles.push_back(static_cast<u16>(face.mIndices[1]));
-            triangles.push_back(static_cast<u16>(face.mIndices[2]));
+            triangles.push_back(face.mIndices[0]);
+            triangles.push_back(face.mIndices[1]);
+            triangles.push_back(face.mIndices[2]);
         }
     }
 
     void process_node(const aiNode* node,
                       const aiScene* scene,
                       std::vector<StaticVertex>& vertices,
-                      std::vector<u16>& triangles,
+                      std::vector<u32>& triangles,
                       std::vector<StaticMesh::Submesh>& submeshes)
     {
         for (sizet i = 0; i < node->mNumMeshes; ++i)
         {
-            aiMesh* mesh = scene->mMeshes[i];
+            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
             process_mesh(mesh, vertices, triangles, submeshes);
         }
 
@@ -70,7 +76,25 @@ namespace mill::asset_browser
         }
     }
 
-    auto import_static_mesh(const std::string& filename) -> Owned<StaticMesh>
+    void compute_submesh_bounds(const std::vector<StaticVertex>& vertices, std::vector<StaticMesh::Submesh>& submeshes)
+    {
+        for (auto& submesh : submeshes)
+        {
+            if (submesh.vertexCount == 0)
+                continue;
+
+            const auto submesh_vertices = std::span(vertices).subspan(submesh.vertexOffset, submesh.vertexCount);
+            submesh.boundsMin = submesh_vertices[0].position;
+            submesh.boundsMax = submesh_vertices[0].position;
+            for (const auto& vertex : submesh_vertices)
+            {
+                submesh.boundsMin = glm::min(submesh.boundsMin, vertex.position);
+                submesh.boundsMax = glm::max(submesh.boundsMax, vertex.position);
+            }
+        }
+    }
+
+    auto import_static_mesh(const std::string& filename, const StaticMeshImportOptions& options) -> Owned<StaticMesh>
     {
         Assimp::Importer importer{};
         const auto* scene = importer.ReadFile(filename, g_StaticMeshImportFlags);
@@ -81,16 +105,72 @@ namespace mill::asset_browser
         }
 
         std::vector<StaticVertex> vertices{};
-        std::vector<u16> triangles{};
+        std::vector<u32> triangles{};
         std::vector<StaticMesh::Submesh> submeshes{};
 
         process_node(scene->mRootNode, scene, vertices, triangles, submeshes);
 
+        if (options.splitForU16Indices)
+        {
+            const auto submesh_count = submeshes.size();
+            split_static_mesh_submeshes(vertices, triangles, submeshes, g_StaticMeshMaxU16VertexCount);
+            if (submeshes.size() != submesh_count)
+            {
+                LOG_INFO("AssetBrowser - StaticMeshImporter - Split <{}> from {} into {} submeshes to fit 16-bit indices.",
+                         filename,
+                         submesh_count,
+                         submeshes.size());
+            }
+        }
+
+        if (options.optimize)
+        {
+            const auto report = optimize_static_mesh(vertices, triangles, submeshes);
+            LOG_INFO("AssetBrowser - StaticMeshImporter - Optimised <{}>: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, overfetch {:.3f} -> {:.3f}",
+                     filename,
+                     report.before.acmr,
+                     report.after.acmr,
+                     report.before.atvr,
+                     report.after.atvr,
+                     report.before.overfetch,
+                     report.after.overfetch);
+        }
+
+        compute_submesh_bounds(vertices, submeshes);
+
+        std::vector<StaticMesh::Lod> lods{};
+        if (!options.lodRatios.empty())
+        {
+            const auto triangle_count = triangles.size() / 3;
+            lods = generate_static_mesh_lods(vertices, triangles, submeshes, options.lodRatios);
+            for (sizet i = 1; i < lods.size(); ++i)
+            {
+                u64 lod_triangle_count = 0;
+                for (const auto& submesh : std::span(submeshes).subspan(lods[i].submeshOffset, lods[i].submeshCount))
+                {
+                    lod_triangle_count += submesh.indexCount / 3;
+                }
+                LOG_INFO("AssetBrowser - StaticMeshImporter - <{}> LOD {}: {} of {} triangles, used below {:.3f} screen size.",
+                         filename,
+                         i,
+                         lod_triangle_count,
+                         triangle_count,
+                         lods[i].maxScreenSize);
+            }
+            if (lods.size() < options.lodRatios.size() + 1)
+            {
+                LOG_WARN("AssetBrowser - StaticMeshImporter - <{}> could only be simplified into {} of {} LODs.",
+                         filename,
+                         lods.size(),
+                         options.lodRatios.size() + 1);
+            }
+        }
+
         auto static_mesh = CreateOwned<StaticMesh>();
         static_mesh->set_submeshes(submeshes);
+        static_mesh->set_lods(lods);
         static_mesh->set_vertices(vertices);
-        static_mesh->set_triangles(triangles);
-        static_mesh->apply();
+        static_mesh->set_indices(triangles);
         return static_mesh;
     }
 
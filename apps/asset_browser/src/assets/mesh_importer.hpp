@@ -3,8 +3,22 @@
 #include <mill/mill.hpp>
 
 #include <string>
+#include <vector>
 
 namespace mill::asset_browser
 {
-    auto import_static_mesh(const std::string& filename) -> Owned<StaticMesh>;
+    struct StaticMeshImportOptions
+    {
+        bool optimize{ true };  // Run each submesh through optimize_static_mesh(), logging the before & after stats
+        /*
+            Split submeshes with too many vertices for 16-bit indices, so the whole mesh can use them. Otherwise such meshes are
+            exported with 32-bit indices.
+        */
+        bool splitForU16Indices{ false };
+        /* Fraction of the triangles each LOD after the first aims for. No LODs are generated if empty. */
+        std::vector<f32> lodRatios{};
+    };
+
+    /* Only fills in the CPU-side mesh data, so it does not touch the RHI and can be called from any thread. */
+    auto import_static_mesh(const std::string& filename, const StaticMeshImportOptions& options = {}) -> Owned<StaticMesh>;
 }
\ No newline at end of file
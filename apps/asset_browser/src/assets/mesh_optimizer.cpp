@@ -0,0 +1,263 @@
+#include "mesh_optimizer.hpp"
+
+#include <meshoptimizer.h>
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace mill::asset_browser
+{
+    namespace
+    {
+        /* Totals over every submesh, so the stats of the whole mesh are not skewed by small submeshes. */
+        struct MeshStatsAccumulator
+        {
+            u64 verticesTransformed{};
+            u64 bytesFetched{};
+            u64 triangleCount{};
+            u64 vertexCount{};
+
+            void add(std::span<const u32> indices, sizet vertex_count)
+            {
+                const auto cache_stats =
+                    meshopt_analyzeVertexCache(indices.data(), indices.size(), vertex_count, g_MeshOptimizerCacheSize, 0, 0);
+                const auto fetch_stats = meshopt_analyzeVertexFetch(indices.data(), indices.size(), vertex_count, sizeof(StaticVertex));
+
+                verticesTransformed += cache_stats.vertices_transformed;
+                bytesFetched += fetch_stats.bytes_fetched;
+                triangleCount += indices.size() / 3;
+                vertexCount += vertex_count;
+            }
+
+            auto get_stats() const -> MeshOptimizationStats
+            {
+                MeshOptimizationStats stats{};
+                if (triangleCount != 0)
+                    stats.acmr = CAST_F32(verticesTransformed) / CAST_F32(triangleCount);
+                if (vertexCount != 0)
+                {
+                    stats.atvr = CAST_F32(verticesTransformed) / CAST_F32(vertexCount);
+                    stats.overfetch = CAST_F32(bytesFetched) / CAST_F32(vertexCount * sizeof(StaticVertex));
+                }
+                return stats;
+            }
+        };
+    }
+
+    auto optimize_static_mesh(std::vector<StaticVertex>& vertices,
+                              std::vector<u32>& triangles,
+                              std::vector<StaticMesh::Submesh>& submeshes) -> MeshOptimizationReport
+    {
+        MeshStatsAccumulator before{};
+        MeshStatsAccumulator after{};
+
+        std::vector<StaticVertex> optimized_vertices{};
+        optimized_vertices.reserve(vertices.size());
+        for (auto& submesh : submeshes)
+        {
+            if (submesh.indexCount == 0)
+            {
+                submesh.vertexOffset = CAST_U32(optimized_vertices.size());
+                submesh.vertexCount = 0;
+                continue;
+            }
+
+            // Submesh indices are relative to its first vertex
+            const auto submesh_vertices = std::span(vertices).subspan(submesh.vertexOffset, submesh.vertexCount);
+            const auto indices = std::span(triangles).subspan(submesh.indexOffset, submesh.indexCount);
+            before.add(indices, submesh_vertices.size());
+
+            meshopt_optimizeVertexCache(indices.data(), indices.data(), indices.size(), submesh_vertices.size());
+            meshopt_optimizeOverdraw(indices.data(),
+                                     indices.data(),
+                                     indices.size(),
+                                     &submesh_vertices[0].position.x,
+                                     submesh_vertices.size(),
+                                     sizeof(StaticVertex),
+                                     g_MeshOptimizerOverdrawThreshold);
+
+            // Written straight into the new vertex array, which also drops any unused vertices
+            const auto vertex_offset = optimized_vertices.size();
+            optimized_vertices.resize(vertex_offset + submesh_vertices.size());
+            const auto vertex_count = meshopt_optimizeVertexFetch(optimized_vertices.data() + vertex_offset,
+                                                                  indices.data(),
+                                                                  indices.size(),
+                                                                  submesh_vertices.data(),
+                                                                  submesh_vertices.size(),
+                                                                  sizeof(StaticVertex));
+            optimized_vertices.resize(vertex_offset + vertex_count);
+
+            submesh.vertexOffset = CAST_U32(vertex_offset);
+            submesh.vertexCount = CAST_U32(vertex_count);
+            after.add(indices, vertex_count);
+        }
+        vertices = std::move(optimized_vertices);
+
+        return { before.get_stats(), after.get_stats() };
+    }
+
+    void split_static_mesh_submeshes(std::vector<StaticVertex>& vertices,
+                                     std::vector<u32>& triangles,
+                                     std::vector<StaticMesh::Submesh>& submeshes,
+                                     u32 max_vertex_count)
+    {
+        ASSERT(max_vertex_count >= 3);
+
+        const bool needs_split = std::ranges::any_of(submeshes, [&](const auto& submesh) { return submesh.vertexCount > max_vertex_count; });
+        if (!needs_split)
+        {
+            return;
+        }
+
+        std::vector<StaticVertex> split_vertices{};
+        std::vector<u32> split_triangles{};
+        std::vector<StaticMesh::Submesh> split_submeshes{};
+        split_vertices.reserve(vertices.size());
+        split_triangles.reserve(triangles.size());
+
+        constexpr u32 g_Unmapped = std::numeric_limits<u32>::max();
+        std::vector<u32> remap{};
+        for (const auto& submesh : submeshes)
+        {
+            const auto submesh_vertices = std::span(vertices).subspan(submesh.vertexOffset, submesh.vertexCount);
+            const auto indices = std::span(triangles).subspan(submesh.indexOffset, submesh.indexCount);
+
+            // Maps the submesh's vertices to their index in the split submesh currently being filled
+            remap.assign(submesh_vertices.size(), g_Unmapped);
+            auto* split = &split_submeshes.emplace_back();
+            *split = { CAST_U32(split_triangles.size()), 0, CAST_U32(split_vertices.size()), 0, submesh.materialIndex };
+
+            for (sizet i = 0; i + 2 < indices.size(); i += 3)
+            {
+                const std::array<u32, 3> triangle = { indices[i], indices[i + 1], indices[i + 2] };
+                const auto new_vertex_count = CAST_U32(std::ranges::count_if(triangle, [&](u32 index) { return remap[index] == g_Unmapped; }));
+                if (split->vertexCount + new_vertex_count > max_vertex_count)
+                {
+                    // Start a new submesh. Only the vertices it references are mapped again.
+                    std::ranges::fill(remap, g_Unmapped);
+                    split = &split_submeshes.emplace_back();
+                    *split = { CAST_U32(split_triangles.size()), 0, CAST_U32(split_vertices.size()), 0, submesh.materialIndex };
+                }
+
+                for (const auto index : triangle)
+                {
+                    if (remap[index] == g_Unmapped)
+                    {
+                        remap[index] = split->vertexCount++;
+                        split_vertices.push_back(submesh_vertices[index]);
+                    }
+                    split_triangles.push_back(remap[index]);
+                    ++split->indexCount;
+                }
+            }
+        }
+
+        vertices = std::move(split_vertices);
+        triangles = std::move(split_triangles);
+        submeshes = std::move(split_submeshes);
+    }
+
+    auto generate_static_mesh_lods(const std::vector<StaticVertex>& vertices,
+                                   std::vector<u32>& triangles,
+                                   std::vector<StaticMesh::Submesh>& submeshes,
+                                   std::span<const f32> lod_ratios) -> std::vector<StaticMesh::Lod>
+    {
+        const auto base_submesh_count = CAST_U32(submeshes.size());
+        std::vector<StaticMesh::Lod> lods{ { 0, base_submesh_count, std::numeric_limits<f32>::max() } };
+        if (lod_ratios.empty() || submeshes.empty())
+        {
+            return lods;
+        }
+
+        // Errors are measured relative to the diameter of the whole mesh's bounding sphere, as the renderer's screen size is
+        auto bounds_min = submeshes[0].boundsMin;
+        auto bounds_max = submeshes[0].boundsMax;
+        for (u32 i = 0; i < base_submesh_count; ++i)
+        {
+            bounds_min = glm::min(bounds_min, submeshes[i].boundsMin);
+            bounds_max = glm::max(bounds_max, submeshes[i].boundsMax);
+        }
+        const auto mesh_diameter = glm::length(bounds_max - bounds_min);
+
+        u64 previous_index_count = 0;
+        for (u32 i = 0; i < base_submesh_count; ++i)
+        {
+            previous_index_count += submeshes[i].indexCount;
+        }
+
+        std::vector<u32> lod_indices{};
+        for (const auto lod_ratio : lod_ratios)
+        {
+            auto& lod = lods.emplace_back();
+            lod.submeshOffset = CAST_U32(submeshes.size());
+            lod.submeshCount = base_submesh_count;
+
+            f32 lod_error = 0.0f;
+            u64 lod_index_count = 0;
+            for (u32 i = 0; i < base_submesh_count; ++i)
+            {
+                // Always simplified from the original, so errors do not accumulate along the chain
+                auto lod_submesh = submeshes[i];
+                const auto submesh_vertices = std::span(vertices).subspan(lod_submesh.vertexOffset, lod_submesh.vertexCount);
+                const auto indices = std::span(triangles).subspan(lod_submesh.indexOffset, lod_submesh.indexCount);
+                if (indices.empty())
+                {
+                    lod_submesh.indexOffset = CAST_U32(triangles.size());
+                    submeshes.push_back(lod_submesh);
+                    continue;
+                }
+
+                const auto target_index_count = static_cast<sizet>(CAST_F32(indices.size() / 3) * std::clamp(lod_ratio, 0.0f, 1.0f)) * 3;
+                f32 result_error = 0.0f;
+                lod_indices.resize(indices.size());
+                // Each submesh is simplified on its own, so lock its open edges to keep the seams with neighbouring submeshes closed
+                lod_indices.resize(meshopt_simplify(lod_indices.data(),
+                                                    indices.data(),
+                                                    indices.size(),
+                                                    &submesh_vertices[0].position.x,
+                                                    submesh_vertices.size(),
+                                                    sizeof(StaticVertex),
+                                                    target_index_count,
+                                                    g_MeshLodMaxError,
+                                                    meshopt_SimplifyLockBorder,
+                                                    &result_error));
+                meshopt_optimizeVertexCache(lod_indices.data(), lod_indices.data(), lod_indices.size(), submesh_vertices.size());
+
+                // Errors are relative to the submesh's extents
+                const auto submesh_scale =
+                    meshopt_simplifyScale(&submesh_vertices[0].position.x, submesh_vertices.size(), sizeof(StaticVertex));
+                lod_error = std::max(lod_error, result_error * submesh_scale);
+
+                lod_submesh.indexOffset = CAST_U32(triangles.size());
+                lod_submesh.indexCount = CAST_U32(lod_indices.size());
+                triangles.insert(triangles.end(), lod_indices.begin(), lod_indices.end());
+                submeshes.push_back(lod_submesh);
+                lod_index_count += lod_indices.size();
+            }
+
+            if (lod_index_count >= previous_index_count)
+            {
+                // Could not be simplified any further, so is no cheaper than the previous LOD
+                triangles.resize(submeshes[lod.submeshOffset].indexOffset);
+                submeshes.resize(lod.submeshOffset);
+                lods.pop_back();
+                break;
+            }
+            previous_index_count = lod_index_count;
+
+            // The error on screen is its fraction of the diameter, scaled by the fraction of the screen the mesh covers
+            const auto relative_error = mesh_diameter > 0.0f ? lod_error / mesh_diameter : 0.0f;
+            const auto max_screen_size = relative_error > 0.0f ? g_MeshLodMaxScreenError / relative_error : std::numeric_limits<f32>::max();
+            lod.maxScreenSize = std::min(max_screen_size, lods[lods.size() - 2].maxScreenSize);
+        }
+
+        return lods;
+    }
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <mill/mill.hpp>
+
+#include <span>
+#include <vector>
+
+namespace mill::asset_browser
+{
+    /* Simulated FIFO post-transform cache size the stats are measured with. */
+    constexpr u32 g_MeshOptimizerCacheSize = 16;
+    /* Triangle order may increase vertex cache misses by up to this factor to reduce overdraw. */
+    constexpr f32 g_MeshOptimizerOverdrawThreshold = 1.05f;
+    /* Largest error a LOD may be simplified to, relative to the extents of each submesh. Limits how far a target ratio is met. */
+    constexpr f32 g_MeshLodMaxError = 0.05f;
+    /* Largest simplification error, as a fraction of the screen's height, a LOD may show before the previous LOD is used. */
+    constexpr f32 g_MeshLodMaxScreenError = 0.002f;
+
+    struct MeshOptimizationStats
+    {
+        f32 acmr{};       // Average cache miss ratio: vertices transformed per triangle. 0.5 is optimal, 3 is the worst case.
+        f32 atvr{};       // Average transformed vertex ratio: vertices transformed per vertex. 1 is optimal.
+        f32 overfetch{};  // Vertex bytes fetched per vertex byte. 1 is optimal.
+    };
+
+    struct MeshOptimizationReport
+    {
+        MeshOptimizationStats before{};
+        MeshOptimizationStats after{};
+    };
+
+    /*
+        Optimises each submesh on its own, in place: reorders triangles for the post-transform vertex cache, then re-orders clusters
+        of them to reduce overdraw, then reorders the vertices in the order they are first used so they are fetched linearly.
+        Vertices not used by any triangle are removed, so submesh vertex offsets & counts can change. Index offsets & counts do not.
+    */
+    auto optimize_static_mesh(std::vector<StaticVertex>& vertices,
+                              std::vector<u32>& triangles,
+                              std::vector<StaticMesh::Submesh>& submeshes) -> MeshOptimizationReport;
+
+    /*
+        Splits every submesh with more than `max_vertex_count` vertices into several, in triangle order, each using at most
+        `max_vertex_count` vertices. Vertices shared across a split are duplicated. Rebuilds all three arrays.
+    */
+    void split_static_mesh_submeshes(std::vector<StaticVertex>& vertices,
+                                     std::vector<u32>& triangles,
+                                     std::vector<StaticMesh::Submesh>& submeshes,
+                                     u32 max_vertex_count);
+
+    /*
+        Builds a LOD chain by simplifying every submesh (quadric edge collapse) to each of `lod_ratios`, the fraction of the
+        original triangles each LOD after the first aims for. The new submeshes & their triangles are appended, sharing the
+        original submesh's vertices & bounds. Submesh borders are locked, so LODs do not crack where submeshes meet.
+        Each LOD's max screen size keeps its error under g_MeshLodMaxScreenError. Stops early once a LOD can not be simplified
+        any further. Returns every LOD, including the original as the first.
+    */
+    auto generate_static_mesh_lods(const std::vector<StaticVertex>& vertices,
+                                   std::vector<u32>& triangles,
+                                   std::vector<StaticMesh::Submesh>& submeshes,
+                                   std::span<const f32> lod_ratios) -> std::vector<StaticMesh::Lod>;
+}
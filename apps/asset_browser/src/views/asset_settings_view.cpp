@@ -2,6 +2,7 @@
 
 #include "../assets/asset_metadata.hpp"
 #include "../assets/asset_export_settings.hpp"
+#include "../assets/asset_import_cache.hpp"
 
 #include <imgui.h>
 
@@ -9,6 +10,11 @@
 
 namespace mill::asset_browser
 {
+    void AssetSettingView::initialise(AssetImportCache& import_cache)
+    {
+        m_importCache = &import_cache;
+    }
+
     void AssetSettingView::set_active_asset(AssetMetadata* asset_metadata)
     {
         m_activeMetadata = asset_metadata;
@@ -35,7 +41,7 @@ namespace mill::asset_browser
                     auto metadata_filename = fs::path(m_activeMetadata->assetFilename).concat(".meta");
                     AssetMetadata::to_file(*m_activeMetadata, metadata_filename);
 
-                    m_activeMetadata->import_asset();
+                    m_activeMetadata->import_asset(*m_importCache);
                 }
 
                 const auto& export_settings = m_activeMetadata->exportSettings;
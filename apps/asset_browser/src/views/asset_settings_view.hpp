@@ -3,15 +3,19 @@
 namespace mill::asset_browser
 {
     struct AssetMetadata;
+    class AssetImportCache;
 
     class AssetSettingView
     {
     public:
+        void initialise(AssetImportCache& import_cache);
+
         void set_active_asset(AssetMetadata* asset_metadata);
 
         void render();
 
     private:
         AssetMetadata* m_activeMetadata;
+        AssetImportCache* m_importCache{ nullptr };
     };
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+project "Resource Bench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    targetname "resource_bench"
+    targetdir("../../bin/" .. outputdir)
+    objdir("../../bin/" .. outputdir .. "/obj/%{prj.name}")
+    debugdir ("../../bin/" .. outputdir)
+    staticruntime "Off"
+
+    flags
+    {
+        "MultiProcessorCompile",
+        "FatalCompileWarnings",
+    }
+    warnings "High"
+    externalwarnings "Off"
+    externalanglebrackets "On"
+    
+    linkoptions { conan_exelinkflags }
+
+    -- The project open benchmark runs the asset pipeline shared with the Asset Browser, without any of its UI
+    files {
+        "src/**",
+        "../asset_browser/src/assets/**"
+    }
+
+    includedirs {
+        "../asset_browser/src/"
+    }
+
+    defines {
+        "MILL_HEADLESS"
+    }
+
+    use_engine()
@@ -0,0 +1,77 @@
+#include "bench_resources.hpp"
+
+#include <yaml-cpp/yaml.h>
+
+#include <format>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+namespace mill::resource_bench
+{
+    auto BenchResourceFactory::load(const ResourceMetadata& /*metadata*/, std::span<const std::byte> data) -> Owned<Resource>
+    {
+        if (data.size() < sizeof(u64))
+        {
+            return nullptr;
+        }
+
+        u64 value{};
+        std::memcpy(&value, data.data(), sizeof(u64));
+        return CreateOwned<BenchResource>(value);
+    }
+
+    auto generate_bench_resources(const fs::path& resource_dir, u32 resource_count, u32 bank_count) -> std::vector<ResourceId>
+    {
+        ASSERT(bank_count != 0);
+
+        std::error_code error{};
+        fs::remove_all(resource_dir, error);
+        fs::create_directories(resource_dir);
+
+        std::vector<ResourceId> ids{};
+        ids.reserve(resource_count);
+
+        const auto resources_per_bank = (resource_count + bank_count - 1) / bank_count;
+        for (u32 bank_index = 0; bank_index < bank_count; ++bank_index)
+        {
+            const auto first_id = bank_index * resources_per_bank + 1;
+            const auto last_id = std::min((bank_index + 1) * resources_per_bank, resource_count);
+            if (first_id > last_id)
+            {
+                break;
+            }
+
+            const auto data_bank_name = std::format("bench_{:04}.bin", bank_index);
+            std::ofstream data_bank(resource_dir / data_bank_name, std::ios::binary);
+
+            YAML::Emitter out{};
+            out << YAML::BeginMap;
+            out << YAML::Key << "resources" << YAML::Value << YAML::BeginSeq;
+            for (u64 id = first_id; id <= last_id; ++id)
+            {
+                const u64 offset = (id - first_id) * sizeof(u64);
+                data_bank.write(reinterpret_cast<const char*>(&id), sizeof(u64));
+
+                out << YAML::BeginMap;
+                out << YAML::Key << "id" << YAML::Value << id;
+                out << YAML::Key << "type" << YAML::Value << get_resource_type_id<BenchResource>();
+                out << YAML::Key << "data_bank" << YAML::Value << data_bank_name;
+                out << YAML::Key << "data_offset" << YAML::Value << offset;
+                out << YAML::Key << "data_size" << YAML::Value << sizeof(u64);
+                out << YAML::Key << "flags" << YAML::Value << 0;
+                out << YAML::EndMap;
+
+                ids.push_back(id);
+            }
+            out << YAML::EndSeq;
+            out << YAML::EndMap;
+
+            std::ofstream metadata_bank(resource_dir / std::format("bench_{:04}.yaml", bank_index));
+            metadata_bank << out.c_str();
+        }
+
+        return ids;
+    }
+
+}
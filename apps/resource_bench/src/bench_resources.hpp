@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mill/mill.hpp>
+
+#include <chrono>
+#include <vector>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace mill::resource_bench
+{
+    /* Resource that needs no GPU, so the resource manager can be measured on its own. Its data is a single u64. */
+    class BenchResource : public Resource
+    {
+    public:
+        DECLARE_RESOURCE_TYPE(BenchResource);
+
+        explicit BenchResource(u64 value) : m_value(value) {}
+
+        auto get_value() const -> u64 { return m_value; }
+
+    private:
+        u64 m_value{};
+    };
+
+    struct BenchResourceFactory : public ResourceFactory
+    {
+        auto load(const ResourceMetadata& metadata, std::span<const std::byte> data) -> Owned<Resource> override;
+    };
+
+    /*
+        Writes a synthetic resource directory of `resource_count` BenchResources, spread evenly over `bank_count` metadata banks,
+        each with its own data bank. Ids are 1 to `resource_count`. Any previous contents of `resource_dir` are removed.
+    */
+    auto generate_bench_resources(const fs::path& resource_dir, u32 resource_count, u32 bank_count) -> std::vector<ResourceId>;
+
+    class BenchTimer
+    {
+    public:
+        explicit BenchTimer() : m_startTime(Clock::now()) {}
+
+        auto get_elapsed_ms() const -> f64
+        {
+            const std::chrono::duration<f64, std::milli> elapsed = Clock::now() - m_startTime;
+            return elapsed.count();
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point m_startTime{};
+    };
+}
@@ -0,0 +1,89 @@
+#include "handle_bench.hpp"
+
+#include "bench_resources.hpp"
+
+#include <format>
+#include <random>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+namespace mill::resource_bench
+{
+    namespace
+    {
+        void print_result(std::string_view name, f64 elapsed_ms, u64 resolve_count)
+        {
+            std::cout << std::format("  {:<28} {:>10.2f}ms {:>8.2f}ns/resolve\n",
+                                     name,
+                                     elapsed_ms,
+                                     elapsed_ms * 1'000'000.0 / static_cast<f64>(resolve_count));
+        }
+    }
+
+    void run_handle_bench(const fs::path& work_dir, u32 resource_count, u32 pass_count)
+    {
+        const auto resource_dir = work_dir / "handles";
+        const auto ids = generate_bench_resources(resource_dir, resource_count, 1);
+
+        ResourceManager manager{};
+        manager.initialise({ .resourcePath = resource_dir.string(), .loaderThreadCount = 1, .useRegistry = false, .hotReload = false });
+        manager.register_resource_type<BenchResource>(CreateOwned<BenchResourceFactory>());
+
+        std::vector<ResourceHandle> handles{};
+        handles.reserve(ids.size());
+        for (const auto id : ids)
+        {
+            handles.push_back(manager.get_handle(id, ResourceLoadPriority::eImmediate));
+        }
+
+        // Shuffled, so neither path benefits from walking memory in order
+        std::vector<u32> order(ids.size());
+        for (u32 i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::shuffle(order.begin(), order.end(), std::mt19937(1234));
+
+        // Resolving once caches each handles slot, as a game would after its first frame
+        u64 checksum = 0;
+        for (auto& handle : handles)
+        {
+            checksum += handle.As<BenchResource>()->get_value();
+        }
+
+        const auto resolve_count = static_cast<u64>(order.size()) * pass_count;
+        std::cout << std::format("Handle resolve: {} resources, {} passes\n", ids.size(), pass_count);
+
+        {
+            const BenchTimer timer{};
+            for (u32 pass = 0; pass < pass_count; ++pass)
+            {
+                for (const auto index : order)
+                {
+                    checksum += handles[index].As<BenchResource>()->get_value();
+                }
+            }
+            print_result("Slot table (As<T>)", timer.get_elapsed_ms(), resolve_count);
+        }
+        {
+            const BenchTimer timer{};
+            for (u32 pass = 0; pass < pass_count; ++pass)
+            {
+                for (const auto index : order)
+                {
+                    checksum += static_cast<BenchResource*>(manager.get_resource(ids[index]))->get_value();
+                }
+            }
+            print_result("Map lookup (get_resource)", timer.get_elapsed_ms(), resolve_count);
+        }
+
+        // Printed so the loops can not be optimised away
+        std::cout << std::format("  Checksum {}\n", checksum);
+
+        handles.clear();
+        manager.tick();
+        manager.shutdown();
+    }
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <mill/mill.hpp>
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace mill::resource_bench
+{
+    /*
+        Loads `resource_count` resources, then resolves every handle `pass_count` times in a shuffled order, through the
+        generation-checked slot table (ResourceHandle::As()) and through the metadata & cache map lookups (get_resource()).
+    */
+    void run_handle_bench(const fs::path& work_dir, u32 resource_count, u32 pass_count);
+}
@@ -0,0 +1,109 @@
+#include "handle_bench.hpp"
+#include "metadata_bench.hpp"
+#include "project_bench.hpp"
+
+#include <mill/mill.hpp>
+
+#include <string>
+#include <optional>
+#include <exception>
+#include <iostream>
+#include <filesystem>
+#include <string_view>
+
+namespace
+{
+    void print_usage()
+    {
+        std::cout << "Usage: resource_bench <handles|metadata|project> [--count <count>] [--threads <count>] [--dir <work_dir>]\n"
+                     "  handles   Times resolving loaded resources through handles against the metadata & cache map lookups.\n"
+                     "  metadata  Times the resource manager starting up from metadata banks, without a compiled registry.\n"
+                     "  project   Times opening a project of small models with an empty and then a warm asset import cache.\n"
+                     "  --count <count>  Number of resources or assets. Defaults to 10000 for handles, 100000 for metadata and 5000 for project.\n"
+                     "  --threads <count>  Number of import threads for project. Defaults to one per hardware thread.\n"
+                     "  --dir <work_dir>  Where synthetic data is generated. Defaults to a directory in the system temp directory.\n";
+    }
+}
+
+/*
+    Microbenchmarks of the resource manager, run against synthetic data so they need no baked project or GPU.
+    Returns 0 once the benchmark has run and 2 if the arguments are invalid.
+*/
+int main(int argc, char** argv)
+{
+    std::string_view bench_name{};
+    std::optional<mill::u32> count{};
+    mill::u32 thread_count{};
+    std::filesystem::path work_dir = std::filesystem::temp_directory_path() / "mill_resource_bench";
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--count" && i + 1 < argc)
+        {
+            try
+            {
+                count = static_cast<mill::u32>(std::stoul(argv[++i]));
+            }
+            catch (const std::exception&)
+            {
+                print_usage();
+                return 2;
+            }
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            try
+            {
+                thread_count = static_cast<mill::u32>(std::stoul(argv[++i]));
+            }
+            catch (const std::exception&)
+            {
+                print_usage();
+                return 2;
+            }
+        }
+        else if (arg == "--dir" && i + 1 < argc)
+        {
+            work_dir = argv[++i];
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            print_usage();
+            return 0;
+        }
+        else if (bench_name.empty() && !arg.starts_with("-"))
+        {
+            bench_name = arg;
+        }
+        else
+        {
+            print_usage();
+            return 2;
+        }
+    }
+
+    if (count == 0)
+    {
+        print_usage();
+        return 2;
+    }
+
+    if (bench_name == "handles")
+    {
+        mill::resource_bench::run_handle_bench(work_dir, count.value_or(10'000), 100);
+        return 0;
+    }
+    if (bench_name == "metadata")
+    {
+        mill::resource_bench::run_metadata_bench(work_dir, count.value_or(100'000), 100, 5);
+        return 0;
+    }
+    if (bench_name == "project")
+    {
+        mill::resource_bench::run_project_bench(work_dir, count.value_or(5'000), thread_count);
+        return 0;
+    }
+
+    print_usage();
+    return 2;
+}
@@ -0,0 +1,46 @@
+#include "metadata_bench.hpp"
+
+#include "bench_resources.hpp"
+
+#include <format>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+namespace mill::resource_bench
+{
+    void run_metadata_bench(const fs::path& work_dir, u32 resource_count, u32 bank_count, u32 run_count)
+    {
+        const auto resource_dir = work_dir / "metadata";
+        {
+            const BenchTimer timer{};
+            generate_bench_resources(resource_dir, resource_count, bank_count);
+            std::cout << std::format("Generated {} resources in {} metadata banks in {:.2f}ms\n",
+                                     resource_count,
+                                     bank_count,
+                                     timer.get_elapsed_ms());
+        }
+
+        std::cout << std::format("Metadata startup: {} resources, {} banks, {} runs\n", resource_count, bank_count, run_count);
+
+        std::vector<f64> run_times_ms{};
+        for (u32 run = 0; run < run_count; ++run)
+        {
+            ResourceManager manager{};
+
+            const BenchTimer timer{};
+            manager.initialise({ .resourcePath = resource_dir.string(), .loaderThreadCount = 1, .useRegistry = false, .hotReload = false });
+            run_times_ms.push_back(timer.get_elapsed_ms());
+
+            ASSERT(manager.has_metadata(resource_count));
+            manager.shutdown();
+
+            std::cout << std::format("  Run {:<3} {:>10.2f}ms\n", run, run_times_ms.back());
+        }
+
+        std::sort(run_times_ms.begin(), run_times_ms.end());
+        const auto median_ms = run_times_ms[run_times_ms.size() / 2];
+        std::cout << std::format("  Median   {:>10.2f}ms {:>8.0f} resources/s\n", median_ms, resource_count * 1000.0 / median_ms);
+    }
+
+}
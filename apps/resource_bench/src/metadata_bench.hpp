@@ -0,0 +1,15 @@
+#pragma once
+
+#include <mill/mill.hpp>
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace mill::resource_bench
+{
+    /*
+        Times ResourceManager::initialise() scanning `resource_count` metadata entries, spread over `bank_count` metadata banks,
+        without a compiled registry. Runs `run_count` times, as the first run also pays for reading the banks from disk.
+    */
+    void run_metadata_bench(const fs::path& work_dir, u32 resource_count, u32 bank_count, u32 run_count);
+}
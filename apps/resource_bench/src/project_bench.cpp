@@ -0,0 +1,99 @@
+#include "project_bench.hpp"
+
+#include "bench_resources.hpp"
+
+#include "assets/asset_type.hpp"
+#include "assets/asset_metadata.hpp"
+#include "assets/asset_job_queue.hpp"
+#include "assets/asset_import_cache.hpp"
+#include "assets/asset_export_settings.hpp"
+
+#include <format>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+namespace mill::resource_bench
+{
+    namespace
+    {
+        using namespace mill::asset_browser;
+
+        /* Writes `asset_count` single triangle .obj files, each with the .meta file the Asset Browser would create on import. */
+        void generate_project_assets(const fs::path& assets_dir, u32 asset_count)
+        {
+            std::error_code error{};
+            fs::remove_all(assets_dir, error);
+            fs::create_directories(assets_dir);
+
+            for (u32 i = 0; i < asset_count; ++i)
+            {
+                const auto asset_filename = assets_dir / std::format("bench_{:05}.obj", i);
+                {
+                    // Offset each triangle, so every source file (and its cache key) is unique
+                    std::ofstream file(asset_filename, std::ios::trunc);
+                    file << std::format("v {} 0 0\nv {} 1 0\nv {} 0 1\nf 1 2 3\n", i, i, i);
+                }
+
+                AssetMetadata metadata{};
+                metadata.id = i + 1;
+                metadata.name = asset_filename.filename().string();
+                metadata.assetFilename = asset_filename;
+                metadata.type = AssetType::eModel;
+                metadata.exportSettings.push_back(create_asset_settings(metadata.type));
+
+                AssetMetadata::to_file(metadata, fs::path(asset_filename).concat(".meta"));
+            }
+        }
+
+        /* Same import flow as bake_project(), without the bake. */
+        void open_project(const fs::path& project_dir, u32 thread_count, const char* label)
+        {
+            const BenchTimer timer{};
+
+            AssetImportCache import_cache{};
+            import_cache.open(project_dir / "intermediate" / "import_cache");
+
+            auto assets = scan_for_asset_metadata(project_dir / "assets");
+            const auto scan_time_ms = timer.get_elapsed_ms();
+
+            AssetJobQueue jobs(thread_count);
+            for (auto& asset_metadata : assets)
+            {
+                jobs.add_job(asset_metadata.name, [&asset_metadata, &import_cache] { return asset_metadata.import_asset(import_cache); });
+            }
+            jobs.wait();
+            import_cache.save();
+
+            const auto open_time_ms = timer.get_elapsed_ms();
+            const auto cache_stats = import_cache.get_stats();
+            std::cout << std::format("  {:<5} {:>10.2f}ms (scan {:.2f}ms) {} hits, {} misses, {} hashed, {} failed\n",
+                                     label,
+                                     open_time_ms,
+                                     scan_time_ms,
+                                     cache_stats.hitCount,
+                                     cache_stats.missCount,
+                                     cache_stats.hashedCount,
+                                     jobs.get_failed_count());
+        }
+    }
+
+    void run_project_bench(const fs::path& work_dir, u32 asset_count, u32 thread_count)
+    {
+        const auto project_dir = work_dir / "project";
+        {
+            const BenchTimer timer{};
+            generate_project_assets(project_dir / "assets", asset_count);
+            std::cout << std::format("Generated {} assets in {:.2f}ms\n", asset_count, timer.get_elapsed_ms());
+        }
+
+        // Start from an empty import cache, so the first open has to import everything
+        std::error_code error{};
+        fs::remove_all(project_dir / "intermediate", error);
+
+        std::cout << std::format("Project open: {} assets\n", asset_count);
+        open_project(project_dir, thread_count, "Cold");
+        open_project(project_dir, thread_count, "Warm");
+    }
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <mill/mill.hpp>
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace mill::resource_bench
+{
+    /*
+        Times opening a synthetic project of `asset_count` small models the way the Asset Browser & Asset Baker do: scanning
+        the asset metadata and importing every asset through the AssetImportCache. The first open starts from an empty cache,
+        the second reuses it, so only the source file hashes are checked.
+        A `thread_count` of 0 uses a thread per hardware thread.
+    */
+    void run_project_bench(const fs::path& work_dir, u32 asset_count, u32 thread_count);
+}
@@ -56,6 +56,12 @@ namespace mill
         return sizeof(T) * vec.size();
     }
 
+    /* Rounds `value` up to the next multiple of `alignment`, which must be a power of two. */
+    constexpr auto align_up(u64 value, u64 alignment) -> u64
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
     template <typename T>
     using Shared = std::shared_ptr<T>;
 
@@ -16,7 +16,7 @@ namespace mill::rhi
     enum class MemoryUsage
     {
         eHost,
-        eDevice,
+        eDevice,  // Not host-visible. Written with upload_buffer()
         eDeviceHostVisble,
     };
 
@@ -31,5 +31,17 @@ namespace mill::rhi
     auto create_buffer(const BufferDescription& description) -> HandleBuffer;
     void write_buffer(HandleBuffer buffer_id, u64 offset, u64 size, const void* data);
 
+    /* Identifies a queued upload. Uploads complete in the order they were queued. */
+    using UploadTicket = u64;
+    /*
+        Queues `data` to be copied into the buffer on the transfer queue, without waiting for it. `data` is copied to staging memory
+        straight away, so it only has to stay valid for the duration of the call. Uploads queued during a frame are submitted together
+        by end_frame(). The buffer must not be used by the GPU until the upload has completed.
+    */
+    auto upload_buffer(HandleBuffer buffer_id, u64 offset, u64 size, const void* data) -> UploadTicket;
+    bool is_upload_complete(UploadTicket ticket);
+    /* Blocks until the upload has completed, submitting it immediately if it has not been yet. */
+    void wait_for_upload(UploadTicket ticket);
+
     void destroy_buffer(u64 buffer_id);
 }
\ No newline at end of file
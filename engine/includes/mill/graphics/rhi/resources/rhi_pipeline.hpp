@@ -11,6 +11,7 @@ namespace mill::rhi
     {
         std::string name{};
         Format format{ Format::eUndefined };
+        u32 binding{};  // Vertex buffer the attribute is read from. Attributes of the same binding are interleaved in order.
     };
 
     enum class PrimitiveTopology : u8
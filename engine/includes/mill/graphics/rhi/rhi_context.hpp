@@ -5,6 +5,8 @@
 
 #include <glm/ext/vector_float4.hpp>
 
+#include <span>
+
 namespace mill::rhi
 {
     void begin_context(u64 context_id);
@@ -23,8 +25,12 @@ namespace mill::rhi
         eU16,
         eU32,
     };
+    constexpr u32 g_MaxVertexBufferBindings = 4;
+
     void set_index_buffer(u64 context_id, HandleBuffer buffer_id, IndexType index_type);
-    void set_vertex_buffer(u64 context_id, HandleBuffer buffer_id);
+    void set_vertex_buffer(u64 context_id, HandleBuffer buffer_id, u32 binding = 0);
+    /* Binds `buffer_ids` to consecutive bindings, starting at `first_binding`. At most g_MaxVertexBufferBindings buffers. */
+    void set_vertex_buffers(u64 context_id, std::span<const HandleBuffer> buffer_ids, u32 first_binding = 0);
 
     void set_resource_sets(u64 context_id, const std::vector<u64>& resource_set_ids);
     void set_push_constants(u64 context_id, u32 offset, u32 size, const void* data);
@@ -15,11 +15,13 @@ namespace mill::rhi
         eR16,
         eR32,
         // RG
+        eRG16F,  // Half float
         eRG32,
         // RGB
         eRGB32,
         // RGBA
         eRGBA8,
+        eRGBA16Unorm,  // Normalized to [0, 1]
         // Depth/Stencil
         eD16,
         eD24S8,
@@ -6,6 +6,12 @@
 #include "mill/graphics/rhi.hpp"
 
 #include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/geometric.hpp>
+
+#include <array>
+#include <limits>
+#include <algorithm>
 
 namespace mill
 {
@@ -125,36 +131,30 @@ namespace mill
                 rhi::bind_buffer_to_resource_set(m_cameraResourceSet, 0, m_cameraUBO);
             }
 
-            // Pipeline
-            {
-                rhi::PipelineDescription pipeline_desc{
-                .vertexInputState = { 
-                    .attributes = {
-                        { "Position", rhi::Format::eRGB32 },
-                        { "TexCoord", rhi::Format::eRG32 },
-                        { "Color", rhi::Format::eRGB32 },
-                    },
-                    .topology = rhi::PrimitiveTopology::eTriangles,
-                    },
-                    .preRasterisationState = {
-                        .vertexSpirv = g_SceneShaderSpirvVS,
-                        .fillMode = rhi::FillMode::eFill,
-                        .cullMode = rhi::CullMode::eNone,
-                        .frontFace = rhi::FrontFace::eClockwise,
-                        .lineWidth = 1.0f,
-                    },
-                    .fragmentStageState = {
-                        .fragmentSpirv = g_SceneShaderSpirvFS,
-                        .depthTest = false,
-                        .stencilTest = false,
-                    },
-                    .fragmentOutputState = {
-                        .enableColorBlend = false,
-                    },
-                };
-
-                m_pipeline = rhi::create_pipeline(pipeline_desc);
-            }
+            // Pipelines
+            // Quantized vertices are read by the same shader. The unorm positions are scaled into their submesh's bounds by the
+            // world matrix, half float texture coordinates read as floats and the color's alpha is ignored.
+            m_pipeline = create_pipeline({
+                { "Position", rhi::Format::eRGB32 },
+                { "TexCoord", rhi::Format::eRG32 },
+                { "Color", rhi::Format::eRGB32 },
+            });
+            m_quantizedPipeline = create_pipeline({
+                { "Position", rhi::Format::eRGBA16Unorm },
+                { "TexCoord", rhi::Format::eRG16F },
+                { "Color", rhi::Format::eRGBA8 },
+            });
+            // Meshes with a separate position stream read their positions from binding 0 and everything else from binding 1
+            m_splitPipeline = create_pipeline({
+                { "Position", rhi::Format::eRGB32, 0 },
+                { "TexCoord", rhi::Format::eRG32, 1 },
+                { "Color", rhi::Format::eRGB32, 1 },
+            });
+            m_quantizedSplitPipeline = create_pipeline({
+                { "Position", rhi::Format::eRGBA16Unorm, 0 },
+                { "TexCoord", rhi::Format::eRG16F, 1 },
+                { "Color", rhi::Format::eRGBA8, 1 },
+            });
 
             // Triangle Vertex Buffer
             {
@@ -197,8 +197,6 @@ namespace mill
                 rhi::set_viewport(context, 0, 0, 1600, 900, 0.0f, 1.0f);
                 rhi::set_scissor(context, 0, 0, 1600, 900);
 
-                rhi::set_pipeline(context, m_pipeline);
-
                 rhi::set_resource_sets(context, { m_cameraResourceSet });
 
                 // rhi::set_push_constants(context, 0, sizeof(glm::mat4), &scene_info.cameraProjMat);
@@ -209,16 +207,43 @@ namespace mill
                     if (instance.staticMesh == nullptr)
                         continue;
 
+                    const bool is_quantized = instance.staticMesh->get_vertex_format() == StaticVertexFormat::eQuantized;
+                    const bool has_position_stream = instance.staticMesh->has_position_stream();
+                    rhi::set_pipeline(context, get_pipeline(is_quantized, has_position_stream));
+
                     const auto index_buffer = instance.staticMesh->get_index_buffer();
-                    rhi::set_index_buffer(context, index_buffer, rhi::IndexType::eU16);
+                    rhi::set_index_buffer(context, index_buffer, instance.staticMesh->get_index_type());
 
                     const auto vertex_buffer = instance.staticMesh->get_vertex_buffer();
-                    rhi::set_vertex_buffer(context, vertex_buffer);
+                    if (has_position_stream)
+                    {
+                        const std::array<rhi::HandleBuffer, 2> vertex_buffers{ instance.staticMesh->get_position_buffer(), vertex_buffer };
+                        rhi::set_vertex_buffers(context, vertex_buffers);
+                    }
+                    else
+                    {
+                        rhi::set_vertex_buffer(context, vertex_buffer);
+                    }
 
                     rhi::set_push_constants(context, 0, sizeof(glm::mat4), &instance.worldMat);
 
-                    const auto index_count = instance.staticMesh->get_index_count();
-                    rhi::draw_indexed(context, index_count, 1, 0, 0);
+                    // Submesh indices are relative to their first vertex
+                    const auto lod = instance.staticMesh->select_lod(get_screen_size(instance, scene_info));
+                    const auto submeshes = instance.staticMesh->get_lod_submeshes(lod);
+                    if (submeshes.empty())
+                    {
+                        rhi::draw_indexed(context, instance.staticMesh->get_index_count(), 1, 0, 0);
+                    }
+                    for (const auto& submesh : submeshes)
+                    {
+                        if (is_quantized)
+                        {
+                            const auto dequantize_mat = glm::scale(glm::translate(instance.worldMat, submesh.boundsMin),
+                                                                   submesh.boundsMax - submesh.boundsMin);
+                            rhi::set_push_constants(context, 0, sizeof(glm::mat4), &dequantize_mat);
+                        }
+                        rhi::draw_indexed(context, submesh.indexCount, 1, submesh.indexOffset, submesh.vertexOffset);
+                    }
                 }
             }
             rhi::end_view(context, m_viewId);
@@ -226,6 +251,62 @@ namespace mill
             return m_viewId;
         }
 
+    private:
+        auto create_pipeline(const std::vector<rhi::VertexAttribute>& vertex_attributes) -> u64
+        {
+            rhi::PipelineDescription pipeline_desc{
+                .vertexInputState = {
+                    .attributes = vertex_attributes,
+                    .topology = rhi::PrimitiveTopology::eTriangles,
+                },
+                .preRasterisationState = {
+                    .vertexSpirv = g_SceneShaderSpirvVS,
+                    .fillMode = rhi::FillMode::eFill,
+                    .cullMode = rhi::CullMode::eNone,
+                    .frontFace = rhi::FrontFace::eClockwise,
+                    .lineWidth = 1.0f,
+                },
+                .fragmentStageState = {
+                    .fragmentSpirv = g_SceneShaderSpirvFS,
+                    .depthTest = false,
+                    .stencilTest = false,
+                },
+                .fragmentOutputState = {
+                    .enableColorBlend = false,
+                },
+            };
+
+            return rhi::create_pipeline(pipeline_desc);
+        }
+
+        /* Fraction of the screen's height covered by the instance's bounding sphere. */
+        static auto get_screen_size(const SceneRenderInstance& instance, const SceneRenderInfo& scene_info) -> f32
+        {
+            const auto& bounds_min = instance.staticMesh->get_bounds_min();
+            const auto& bounds_max = instance.staticMesh->get_bounds_max();
+            const auto center = instance.worldMat * glm::vec4((bounds_min + bounds_max) * 0.5f, 1.0f);
+
+            const auto max_scale = std::max({ glm::length(glm::vec3(instance.worldMat[0])),
+                                              glm::length(glm::vec3(instance.worldMat[1])),
+                                              glm::length(glm::vec3(instance.worldMat[2])) });
+            const auto radius = glm::length(bounds_max - bounds_min) * 0.5f * max_scale;
+
+            // Inside the sphere, it covers the whole screen
+            const auto distance = glm::length(glm::vec3(scene_info.cameraViewMat * center));
+            if (distance <= radius)
+                return std::numeric_limits<f32>::max();
+
+            return radius * scene_info.cameraProjMat[1][1] / distance;
+        }
+
+        auto get_pipeline(bool is_quantized, bool has_position_stream) const -> u64
+        {
+            if (has_position_stream)
+                return is_quantized ? m_quantizedSplitPipeline : m_splitPipeline;
+
+            return is_quantized ? m_quantizedPipeline : m_pipeline;
+        }
+
     private:
         u64 m_viewId{};
 
@@ -234,6 +315,9 @@ namespace mill
         CameraUniforms m_cameraUniforms{};
 
         u64 m_pipeline{};
+        u64 m_quantizedPipeline{};
+        u64 m_splitPipeline{};
+        u64 m_quantizedSplitPipeline{};
         rhi::HandleBuffer m_triangleIndexBuffer{};
         rhi::HandleBuffer m_triangleVertexBuffer{};
     };
@@ -3,19 +3,28 @@
 #include "mill/core/base.hpp"
 #include "static_vertex.hpp"
 #include "rhi/resources/rhi_buffer.hpp"
+#include "rhi/rhi_context.hpp"
 #include "mill/resources/resource.hpp"
 
 #include <glm/ext/vector_float2.hpp>
 #include <glm/ext/vector_float3.hpp>
 #include <glm/ext/vector_float4.hpp>
 
+#include <span>
+#include <limits>
 #include <vector>
+#include <cstddef>
 
 namespace mill
 {
+    /* Largest vertex count a submesh can have and still use 16-bit indices. 0xFFFF is kept free for primitive restart. */
+    constexpr u32 g_StaticMeshMaxU16VertexCount = std::numeric_limits<u16>::max();
+
     class StaticMesh : public Resource
     {
     public:
+        DECLARE_RESOURCE_TYPE(StaticMesh);
+
         struct Submesh
         {
             u32 indexOffset{};
@@ -23,35 +32,108 @@ namespace mill
             u32 vertexOffset{};
             u32 vertexCount{};
             u32 materialIndex{};
+            glm::vec3 boundsMin{};  // Quantized vertex positions are relative to these bounds
+            glm::vec3 boundsMax{};
+        };
+
+        /*
+            A level of detail, drawn with its own range of submeshes. LODs after the first reuse the vertices of the first LOD's
+            submeshes with fewer triangles, so only add indices.
+        */
+        struct Lod
+        {
+            u32 submeshOffset{};
+            u32 submeshCount{};
+            f32 maxScreenSize{};  // Used while the mesh's bounding sphere covers at most this fraction of the screen's height
         };
 
         explicit StaticMesh() = default;
-        ~StaticMesh() = default;
+        ~StaticMesh() override = default;
+
+        /* Moving does not touch the GPU buffers, they belong to whichever mesh they end up in. */
+        StaticMesh(StaticMesh&&) noexcept = default;
+        auto operator=(StaticMesh&&) noexcept -> StaticMesh& = default;
 
         void set_vertices(const std::vector<StaticVertex>& vertices);
-        void set_triangles(const std::vector<u16>& triangles);
+        /* Indices are relative to the first vertex of their submesh. Narrowed to u16 on upload if every submesh allows it. */
+        void set_indices(const std::vector<u32>& indices);
         void set_submeshes(const std::vector<Submesh>& submeshes);
+        /* Without LODs, every submesh is drawn at all screen sizes. */
+        void set_lods(const std::vector<Lod>& lods);
 
+        /*
+            Use tightly packed vertex/index data (eg. a slice of a memory-mapped data bank) as the source for the next apply(),
+            instead of the CPU-side vectors. The memory is not copied and must remain valid until apply() has been called.
+            If `position_data` is given, the positions are uploaded to their own buffer and `vertex_data` only holds the
+            remaining attributes (see StaticVertexAttributes).
+        */
+        void set_vertex_data(std::span<const std::byte> vertex_data,
+                             StaticVertexFormat vertex_format,
+                             std::span<const std::byte> position_data = {});
+        void set_index_data(std::span<const std::byte> index_data, rhi::IndexType index_type);
+
+        /* Creates the GPU buffers and queues their uploads. They must not be drawn until is_uploaded() returns true. */
         void apply();
+        /* Destroys the GPU buffers created by apply(). */
+        void release();
+
+        bool is_uploaded() const;
+        void wait_until_uploaded() const;
 
         /* Getters */
 
         auto get_vertices() const -> const std::vector<StaticVertex>&;
-        auto get_indices() const -> const std::vector<u16>&;
+        auto get_indices() const -> const std::vector<u32>&;
         auto get_submeshes() const -> const std::vector<Submesh>&;
+        auto get_lods() const -> const std::vector<Lod>&;
+        /* Always at least 1. */
+        auto get_lod_count() const -> u32;
+        auto get_lod_submeshes(u32 lod) const -> std::span<const Submesh>;
+        /* The coarsest LOD allowed at `screen_size`, the fraction of the screen's height covered by the bounding sphere. */
+        auto select_lod(f32 screen_size) const -> u32;
+        /* Bounds of every submesh. Zero for meshes exported without submesh bounds. */
+        auto get_bounds_min() const -> const glm::vec3&;
+        auto get_bounds_max() const -> const glm::vec3&;
 
         auto get_index_count() const -> u32;
+        /* Index type of the GPU index buffer. Only valid once apply() has been called. */
+        auto get_index_type() const -> rhi::IndexType;
+        /* Vertex format of the GPU vertex buffer. The CPU-side vertices are always StaticVertex. */
+        auto get_vertex_format() const -> StaticVertexFormat;
         auto get_index_buffer() const -> rhi::HandleBuffer;
         auto get_vertex_buffer() const -> rhi::HandleBuffer;
+        /* Null unless the mesh has a separate position stream, in which case the vertex buffer holds the other attributes. */
+        auto get_position_buffer() const -> rhi::HandleBuffer;
+        bool has_position_stream() const;
+
+        auto get_cpu_size() const -> u64 override;
+        auto get_gpu_size() const -> u64 override;
+
+        /* The narrowest index type that can index every vertex of each of `submeshes`. */
+        static auto select_index_type(std::span<const Submesh> submeshes) -> rhi::IndexType;
 
     private:
         std::vector<StaticVertex> m_vertices{};
-        std::vector<u16> m_triangles{};
+        std::vector<u32> m_indices{};
         // TODO: Materials
         std::vector<Submesh> m_submeshes{};
+        std::vector<Lod> m_lods{};
+        glm::vec3 m_boundsMin{};
+        glm::vec3 m_boundsMax{};
+
+        std::span<const std::byte> m_vertexData{};
+        std::span<const std::byte> m_positionData{};
+        std::span<const std::byte> m_indexData{};
 
         u32 m_indexCount{};
+        rhi::IndexType m_indexType{ rhi::IndexType::eU16 };
+        StaticVertexFormat m_vertexFormat{ StaticVertexFormat::eFloat };
         rhi::HandleBuffer m_indexBuffer{};
         rhi::HandleBuffer m_vertexBuffer{};
+        rhi::HandleBuffer m_positionBuffer{};
+        u64 m_indexBufferSize{};
+        u64 m_vertexBufferSize{};
+        u64 m_positionBufferSize{};
+        rhi::UploadTicket m_uploadTicket{};  // All buffers are uploaded together, so this is the ticket of the last upload
     };
 }
\ No newline at end of file
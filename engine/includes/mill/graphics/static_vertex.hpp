@@ -1,5 +1,7 @@
 #pragma once
 
+#include "mill/core/base.hpp"
+
 #include <glm/ext/vector_float2.hpp>
 #include <glm/ext/vector_float3.hpp>
 
@@ -11,4 +13,37 @@ namespace mill
         glm::vec2 texCoord{};
         glm::vec3 color{};
     };
-}
\ No newline at end of file
+
+    /*
+        Half the size of a StaticVertex. Positions are 16-bit unorm within the bounds of their submesh (the 4th component is padding),
+        texture coordinates are half floats and colors are 8-bit unorm.
+    */
+    struct QuantizedStaticVertex
+    {
+        u16 position[4]{};
+        u16 texCoord[2]{};
+        u8 color[4]{};
+    };
+
+    /*
+        Vertices split into a tightly packed position stream (glm::vec3 or the quantized u16[4]) and a stream of the remaining
+        attributes, so passes that only need positions (eg. depth & shadows) fetch only them.
+    */
+    struct StaticVertexAttributes
+    {
+        glm::vec2 texCoord{};
+        glm::vec3 color{};
+    };
+
+    struct QuantizedStaticVertexAttributes
+    {
+        u16 texCoord[2]{};
+        u8 color[4]{};
+    };
+
+    enum class StaticVertexFormat : u8
+    {
+        eFloat,      // StaticVertex
+        eQuantized,  // QuantizedStaticVertex
+    };
+}
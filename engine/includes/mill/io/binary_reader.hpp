@@ -3,6 +3,7 @@
 #include "data_reader.hpp"
 
 #include <string>
+#include <vector>
 #include <fstream>
 #include <ios>
 #include <filesystem>
@@ -10,13 +11,16 @@
 namespace mill
 {
     /**
-     * @brief Read binary data from disk.
+     * @brief Read binary data from disk. Reads are served from an internal block buffer, which is refilled from the file one
+     * large block at a time. Bulk reads that are larger than the buffer go straight to the file.
      */
     class BinaryReader : public DataReader
     {
     public:
-        explicit BinaryReader(const std::string& filename);
-        explicit BinaryReader(const std::filesystem::path& filename);
+        static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+        explicit BinaryReader(const std::string& filename, size_t block_size = DefaultBlockSize);
+        explicit BinaryReader(const std::filesystem::path& filename, size_t block_size = DefaultBlockSize);
         ~BinaryReader();
 
         void skip_bytes(size_t num_bytes) override;
@@ -36,9 +40,22 @@ namespace mill
 
         auto read_str() -> std::string override;
 
+        void read_bytes(std::span<std::byte> bytes) override;
+
+    private:
+        template <typename T>
+        auto read_value() -> T;
+
+        void read_raw(void* data, size_t size);
+        bool fill_buffer();
+
     private:
         std::filesystem::path m_filename;
         std::ifstream m_stream;
+
+        std::vector<char> m_buffer{};
+        size_t m_bufferPos{};
+        size_t m_bufferSize{};
     };
 
-}
\ No newline at end of file
+}
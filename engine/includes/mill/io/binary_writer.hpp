@@ -3,23 +3,30 @@
 #include "data_writer.hpp"
 
 #include <string>
+#include <vector>
 #include <fstream>
 #include <filesystem>
 
 namespace mill
 {
     /**
-     * @brief Write binary data to disk.
+     * @brief Write binary data to disk. Writes are gathered in an internal block buffer, which is written to the file one large
+     * block at a time. Bulk writes that are larger than the buffer go straight to the file.
      */
     class BinaryWriter final : public DataWriter
     {
     public:
-        explicit BinaryWriter(const std::string& filename);
-        explicit BinaryWriter(const std::filesystem::path& filename);
+        static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+        explicit BinaryWriter(const std::string& filename, size_t block_size = DefaultBlockSize);
+        explicit BinaryWriter(const std::filesystem::path& filename, size_t block_size = DefaultBlockSize);
         ~BinaryWriter();
 
         void clear() override;
 
+        /* Writes any buffered data out to the file. */
+        void flush();
+
         void write_i8(int8_t value) override;
         void write_i16(int16_t value) override;
         void write_i32(int32_t value) override;
@@ -35,9 +42,20 @@ namespace mill
 
         void write(const std::string& str) override;
 
+        void write_bytes(std::span<const std::byte> bytes) override;
+
+    private:
+        template <typename T>
+        void write_value(T value);
+
+        void write_raw(const void* data, size_t size);
+
     private:
         std::filesystem::path m_filename;
         std::ofstream m_stream;
+
+        std::vector<char> m_buffer{};
+        size_t m_bufferSize{};
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "mill/core/base.hpp"
+
+#include <span>
+#include <vector>
+#include <cstddef>
+
+namespace mill
+{
+    enum class CompressionCodec : u8
+    {
+        eNone = 0,
+        eLZ4 = 1,   // Very fast decompression, moderate ratio
+        eZstd = 2,  // Better ratio, slower decompression
+    };
+
+    auto get_codec_name(CompressionCodec codec) -> const char*;
+
+    /**
+     * @brief Compresses `data` with `codec`, using a high (slow) compression level as this is intended for offline use.
+     * @return The compressed data, or an empty vector if compression failed.
+     */
+    auto compress(CompressionCodec codec, std::span<const std::byte> data) -> std::vector<std::byte>;
+
+    /**
+     * @brief Decompresses `data` directly into `out`, which must be exactly the size of the uncompressed data.
+     * @return False if the data is corrupt or does not decompress to the size of `out`.
+     */
+    bool decompress(CompressionCodec codec, std::span<const std::byte> data, std::span<std::byte> out);
+
+}
@@ -1,7 +1,11 @@
 #pragma once
 
-#include <cstdint>
+#include <span>
+#include <vector>
 #include <string>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
 
 namespace mill
 {
@@ -31,5 +35,26 @@ namespace mill
         virtual auto read_f64() -> double = 0;
 
         virtual auto read_str() -> std::string = 0;
+
+        /* Fills `bytes` with the next `bytes.size()` bytes. Any bytes that could not be read are zeroed. */
+        virtual void read_bytes(std::span<std::byte> bytes) = 0;
+
+        /**
+         * @brief Reads a whole array of trivially copyable values with a single call.
+         */
+        template <typename T, size_t Extent>
+        void read_array(std::span<T, Extent> values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            read_bytes(std::as_writable_bytes(values));
+        }
+
+        template <typename T>
+        auto read_array(size_t count) -> std::vector<T>
+        {
+            std::vector<T> values(count);
+            read_array(std::span(values));
+            return values;
+        }
     };
-}
\ No newline at end of file
+}
@@ -1,7 +1,10 @@
 #pragma once
 
-#include <cstdint>
+#include <span>
 #include <string>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
 
 namespace mill
 {
@@ -31,6 +34,19 @@ namespace mill
         virtual void write_f64(double value) = 0;
 
         virtual void write(const std::string& str) = 0;
+
+        /* Writes the bytes as-is, without a length prefix. */
+        virtual void write_bytes(std::span<const std::byte> bytes) = 0;
+
+        /**
+         * @brief Writes a whole array of trivially copyable values with a single call, without a length prefix.
+         */
+        template <typename T, size_t Extent>
+        void write_array(std::span<T, Extent> values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            write_bytes(std::as_bytes(values));
+        }
     };
 
     /**
@@ -60,6 +76,8 @@ namespace mill
 
         void write(const std::string& str) override;
 
+        void write_bytes(std::span<const std::byte> bytes) override;
+
         auto get_data_size() const -> size_t;
 
     private:
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "mill/core/base.hpp"
+
+#include <map>
+#include <chrono>
+#include <vector>
+#include <filesystem>
+#include <unordered_map>
+
+namespace mill
+{
+    /**
+     * @brief Watches a directory (and its sub-directories) for files that have been written to.
+     * Uses inotify on Linux. Other platforms fall back to periodically comparing file modification times.
+     */
+    class FileWatcher
+    {
+    public:
+        explicit FileWatcher(const std::filesystem::path& directory);
+        ~FileWatcher();
+
+        DISABLE_COPY_AND_MOVE(FileWatcher);
+
+        /* Returns the files that have finished being written to since the last poll, without duplicates. Never blocks. */
+        auto poll() -> std::vector<std::filesystem::path>;
+
+        /* Getters */
+
+        bool is_watching() const;
+
+        auto get_directory() const -> const std::filesystem::path&;
+
+    private:
+        std::filesystem::path m_directory;
+        bool m_isWatching{ false };
+
+#if MILL_LINUX
+        void add_watch(const std::filesystem::path& directory);
+
+        int m_inotifyFd{ -1 };
+        std::unordered_map<int, std::filesystem::path> m_watchedDirectories{};
+#else
+        void scan(std::vector<std::filesystem::path>* changed_files);
+
+        std::map<std::filesystem::path, std::filesystem::file_time_type> m_fileTimes{};
+        std::chrono::steady_clock::time_point m_lastScanTime{};
+#endif
+    };
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "mill/core/base.hpp"
+
+#include <span>
+#include <cstddef>
+#include <filesystem>
+
+namespace mill
+{
+    /**
+     * @brief Read-only memory mapping of a whole file on disk.
+     *
+     * The file must not be written to in place while mapped. Replace it by renaming a new file over it instead, which leaves
+     * the existing mapping reading the previous contents.
+     */
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path& filename);
+        ~MappedFile();
+
+        DISABLE_COPY_AND_MOVE(MappedFile);
+
+        /* Getters */
+
+        bool is_open() const;
+
+        auto get_filename() const -> const std::filesystem::path&;
+        auto get_size() const -> u64;
+        auto get_data() const -> std::span<const std::byte>;
+
+        /* Returns an empty span if the range does not lie within the file. */
+        auto get_slice(u64 offset, u64 size) const -> std::span<const std::byte>;
+
+    private:
+        std::filesystem::path m_filename;
+        bool m_isOpen{ false };
+
+        const std::byte* m_data{ nullptr };
+        u64 m_size{};
+
+#if MILL_WINDOWS
+        void* m_fileHandle{ nullptr };
+        void* m_mappingHandle{ nullptr };
+#endif
+    };
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "data_reader.hpp"
+
+#include <span>
+#include <string>
+#include <cstddef>
+
+namespace mill
+{
+    /**
+     * @brief Read binary data from a block of memory (eg. a slice of a memory-mapped file). The memory is not owned by the reader.
+     */
+    class MemoryReader final : public DataReader
+    {
+    public:
+        explicit MemoryReader(std::span<const std::byte> data);
+        ~MemoryReader() = default;
+
+        void skip_bytes(size_t num_bytes) override;
+
+        auto read_i8() -> int8_t override;
+        auto read_i16() -> int16_t override;
+        auto read_i32() -> int32_t override;
+        auto read_i64() -> int64_t override;
+
+        auto read_u8() -> uint8_t override;
+        auto read_u16() -> uint16_t override;
+        auto read_u32() -> uint32_t override;
+        auto read_u64() -> uint64_t override;
+
+        auto read_f32() -> float override;
+        auto read_f64() -> double override;
+
+        auto read_str() -> std::string override;
+
+        void read_bytes(std::span<std::byte> bytes) override;
+
+        /* Returns a view of the next `num_bytes` bytes without copying them, or an empty span if there are not enough bytes left. */
+        auto view_bytes(size_t num_bytes) -> std::span<const std::byte>;
+
+        /* Getters */
+
+        auto get_position() const -> size_t;
+        auto get_remaining_size() const -> size_t;
+        bool has_overrun() const;
+
+    private:
+        template <typename T>
+        auto read_value() -> T;
+
+    private:
+        std::span<const std::byte> m_data;
+        size_t m_position{};
+        bool m_hasOverrun{ false };
+    };
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "data_writer.hpp"
+
+#include <span>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace mill
+{
+    /**
+     * @brief Write binary data into a growable block of memory. Useful for round-tripping and benchmarking serializers without
+     * touching disk, or for building up data before writing it out in one go.
+     */
+    class MemoryWriter final : public DataWriter
+    {
+    public:
+        MemoryWriter() = default;
+        explicit MemoryWriter(size_t reserve_size);
+        ~MemoryWriter() = default;
+
+        void clear() override;
+
+        void write_i8(int8_t value) override;
+        void write_i16(int16_t value) override;
+        void write_i32(int32_t value) override;
+        void write_i64(int64_t value) override;
+
+        void write_u8(uint8_t value) override;
+        void write_u16(uint16_t value) override;
+        void write_u32(uint32_t value) override;
+        void write_u64(uint64_t value) override;
+
+        void write_f32(float value) override;
+        void write_f64(double value) override;
+
+        void write(const std::string& str) override;
+
+        void write_bytes(std::span<const std::byte> bytes) override;
+
+        /* Getters */
+
+        auto get_data() const -> std::span<const std::byte>;
+        auto get_data_size() const -> size_t;
+
+        /* Moves the written data out of the writer, leaving it empty. */
+        auto release_data() -> std::vector<std::byte>;
+
+    private:
+        template <typename T>
+        void write_value(T value);
+
+    private:
+        std::vector<std::byte> m_data{};
+    };
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "mill/core/base.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+
+namespace mill
+{
+    /**
+     * @brief Writes events in the Chrome trace event format (JSON), for viewing in chrome://tracing or Perfetto.
+     * Events are streamed to the file as they are added, so a capture can still be opened if the process exits without closing it.
+     * Thread-safe.
+     */
+    class TraceWriter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit TraceWriter() = default;
+        ~TraceWriter();
+
+        DISABLE_COPY_AND_MOVE(TraceWriter);
+
+        /* Starts a new capture, ending the current one. Returns false if the file could not be opened. */
+        bool open(const std::filesystem::path& filename);
+        void close();
+
+        /*
+            Adds a span of work done by a thread. Spans on the same thread must be nested.
+            `args_json` is an optional JSON object of extra values to show with the event, eg. `{"id":42}`.
+        */
+        void add_complete_event(std::string_view name,
+                                std::string_view category,
+                                u32 thread_id,
+                                Clock::time_point start,
+                                Clock::time_point end,
+                                std::string_view args_json = {});
+
+        /* Adds a span that may overlap others, eg. time spent waiting in a queue. Spans are grouped into rows by their id. */
+        void add_async_event(std::string_view name,
+                             std::string_view category,
+                             u64 id,
+                             Clock::time_point start,
+                             Clock::time_point end,
+                             std::string_view args_json = {});
+
+        /* Names the row a thread's events are shown on. */
+        void set_thread_name(u32 thread_id, std::string_view name);
+
+        /* Getters */
+
+        bool is_open() const;
+
+    private:
+        void write_event(const std::string& event_json);
+        auto get_timestamp_us(Clock::time_point time) const -> i64;
+
+    private:
+        mutable std::mutex m_mutex{};
+        std::ofstream m_file{};
+        std::atomic<bool> m_isOpen{ false };
+        bool m_hasEvents{ false };
+        Clock::time_point m_startTime{};
+    };
+
+}
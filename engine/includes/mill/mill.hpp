@@ -30,6 +30,12 @@
 #include "io/data_reader.hpp"
 #include "io/binary_writer.hpp"
 #include "io/binary_reader.hpp"
+#include "io/memory_writer.hpp"
+#include "io/memory_reader.hpp"
+#include "io/mapped_file.hpp"
+#include "io/compression.hpp"
+#include "io/file_watcher.hpp"
+#include "io/trace_writer.hpp"
 
 #include "utility/random.hpp"
 #include "utility/signal.hpp"
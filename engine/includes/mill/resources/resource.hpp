@@ -3,19 +3,34 @@
 #include "mill/core/base.hpp"
 #include "mill/utility/flags.hpp"
 #include "mill/utility/ref_count.hpp"
+#include "mill/io/compression.hpp"
 
 #include <string>
+#include <vector>
+#include <concepts>
+#include <string_view>
 
 namespace mill
 {
     using ResourceId = u64;
 
+    /*
+        Identifies the type of a resource in its metadata. Derived from the name a resource type declares with DECLARE_RESOURCE_TYPE(),
+        so it is the same in every build. Renaming a resource type changes its id, so its resources must be re-baked.
+    */
     using ResourceTypeId = u32;
-    constexpr ResourceTypeId ResourceType_StaticMesh = 0;
-    constexpr ResourceTypeId ResourceType_SkeletalMesh = 1;
-    constexpr ResourceTypeId ResourceType_Material = 2;
-    constexpr ResourceTypeId ResourceType_Audio = 3;
-    constexpr ResourceTypeId ResourceType_Scene = 4;
+
+    /* 32-bit FNV-1a hash of the resource types name. */
+    constexpr auto get_resource_type_id(std::string_view type_name) -> ResourceTypeId
+    {
+        u32 hash = 2166136261u;
+        for (const char c : type_name)
+        {
+            hash ^= static_cast<u8>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
 
     enum class ResourceFlagBits : u8
     {
@@ -24,23 +39,77 @@ namespace mill
     };
     using ResourceFlags = Flags<ResourceFlagBits>;
 
+    /* Index of a loaded resource in the resource managers slot table. The generation changes each time the slot is reused. */
+    struct ResourceSlot
+    {
+        u32 index{ u32_max };
+        u32 generation{};
+    };
+
     struct ResourceMetadata
     {
         ResourceId id{};
         std::string binaryFile{};  // The binary file the resource is loaded from
         u64 binaryOffset{};
-        u64 binarySize{};
+        u64 binarySize{};        // Size of the resource in its binary file, compressed if `codec` is not eNone
+        u64 uncompressedSize{};  // Size of the resource once decompressed. Equal to `binarySize` if not compressed.
+        CompressionCodec codec{ CompressionCodec::eNone };
         ResourceTypeId typeId{};
         ResourceFlags flags{};
+        std::vector<ResourceId> dependencies{};  // Resources that must be loaded for this resource to be usable
 
         bool isLoaded{ false };
-        RefCount refCount{};
+        RefCount refCount{};  // Number of live `ResourceHandle`s to the resource
+        ResourceSlot slot{};  // Only valid while the resource is loaded
     };
 
     class Resource
     {
     public:
         virtual ~Resource() = default;
+
+        /* Implemented by DECLARE_RESOURCE_TYPE(). */
+        virtual auto get_type_id() const -> ResourceTypeId = 0;
+
+        /* Memory owned by the resource, used to keep its cache within budget. Only queried once the resource has been loaded. */
+        virtual auto get_cpu_size() const -> u64 { return 0; }
+        virtual auto get_gpu_size() const -> u64 { return 0; }
     };
 
+    /* Declares a class as a resource type, giving it a type id derived from `_name`. Must be used inside the class body. */
+#define DECLARE_RESOURCE_TYPE(_name)                                                 \
+    static constexpr std::string_view ResourceTypeName = #_name;                     \
+    auto get_type_id() const -> ::mill::ResourceTypeId override                      \
+    {                                                                                \
+        return ::mill::get_resource_type_id(ResourceTypeName);                       \
+    }
+
+    /* Resources are moved into their typed cache once loaded, so must be move-constructible. */
+    template <typename T>
+    concept IsResourceType = std::derived_from<T, Resource> && std::move_constructible<T> && requires {
+        {
+            T::ResourceTypeName
+        } -> std::convertible_to<std::string_view>;
+    };
+
+    template <IsResourceType T>
+    constexpr auto get_resource_type_id() -> ResourceTypeId
+    {
+        return get_resource_type_id(T::ResourceTypeName);
+    }
+
+    /* Returns the next unused resource type index. Used by get_resource_type_index(). Thread-safe. */
+    auto allocate_resource_type_index() -> u32;
+
+    /*
+        Dense index of a resource type, assigned the first time it is requested, so typed lookups are a direct array index.
+        Only stable for the lifetime of the process, so it must never be stored (use the type id instead).
+    */
+    template <IsResourceType T>
+    auto get_resource_type_index() -> u32
+    {
+        static const u32 s_Index = allocate_resource_type_index();
+        return s_Index;
+    }
+
 }
\ No newline at end of file
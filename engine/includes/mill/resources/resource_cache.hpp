@@ -2,28 +2,164 @@
 
 #include "mill/core/base.hpp"
 #include "resource.hpp"
+#include "resource_pool.hpp"
 
+#include <list>
+#include <vector>
+#include <functional>
 #include <unordered_map>
 
 namespace mill
 {
     struct ResourceFactorySystems;
 
+    struct ResourceCacheBudget
+    {
+        u64 cpuBytes = u64_max;
+        u64 gpuBytes = u64_max;
+    };
+
+    struct ResourceCacheStats
+    {
+        u64 hits{};
+        u64 misses{};
+        u64 evictions{};
+
+        u64 residentCount{};
+        u64 residentCpuBytes{};
+        u64 residentGpuBytes{};
+    };
+
+    /*
+        Owns the loaded resources of a single type. Storage is provided by `TypedResourceCache<T>`.
+        Resources are kept in least-recently used order so that, when the cache is over budget, the resources that have gone
+        unused the longest are evicted first.
+    */
     class ResourceCache
     {
     public:
+        using CanEvictFunc = std::function<bool(ResourceId)>;
+
         explicit ResourceCache() = default;
-        ~ResourceCache() = default;
+        virtual ~ResourceCache() = default;
 
         DISABLE_COPY_AND_MOVE(ResourceCache);
 
-        void add(ResourceId id, Owned<Resource> resource);
+        /*
+            Moves the resource into the caches storage, returning where it now lives. The address stays the same until the resource
+            is removed, including across replace().
+        */
+        auto add(ResourceId id, Owned<Resource> resource) -> Resource*;
+        /* Returns nullptr if the resource is not in the cache. Counts towards hits/misses and marks the resource as most-recently used. */
         auto get(ResourceId id) -> Resource*;
+        /* Same as get(), but does not affect the stats or LRU order. */
+        auto find(ResourceId id) const -> Resource*;
+        /* Marks the resource as most-recently used, without affecting the stats. */
+        void touch(ResourceId id);
         void erase(ResourceId id);
-        bool contains(ResourceId id);
+        bool contains(ResourceId id) const;
+
+        /* Swaps in a new version of a cached resource, in-place and keeping its place in the LRU order. Returns the previous version. */
+        auto replace(ResourceId id, Owned<Resource> resource) -> Owned<Resource>;
+
+        /* Removes the resource from the cache, returning ownership of it. Counted as an eviction. */
+        auto evict(ResourceId id) -> Owned<Resource>;
+
+        /*
+            Returns the resources that should be evicted, least-recently used first, to bring the cache back within budget.
+            Only resources `can_evict` returns true for are considered.
+        */
+        auto get_eviction_candidates(const CanEvictFunc& can_evict) const -> std::vector<ResourceId>;
+
+        void set_budget(const ResourceCacheBudget& budget);
+
+        /* Getters */
+
+        auto get_budget() const -> const ResourceCacheBudget&;
+        auto get_stats() const -> ResourceCacheStats;
+
+        /* Returns false if neither the CPU nor GPU budget has been limited. */
+        bool has_budget() const;
+        bool is_over_budget() const;
+
+    protected:
+        /* Storage. Each returns or takes the index the resource is stored at. */
+
+        virtual auto store(Owned<Resource> resource) -> u32 = 0;
+        virtual auto get_stored(u32 index) -> Resource* = 0;
+        virtual auto extract_stored(u32 index) -> Owned<Resource> = 0;
+        virtual auto exchange_stored(u32 index, Owned<Resource> resource) -> Owned<Resource> = 0;
+
+    private:
+        auto remove(ResourceId id) -> Owned<Resource>;
+
+    private:
+        struct CacheEntry
+        {
+            Resource* resource{ nullptr };
+            u32 storageIndex{};
+            u64 cpuSize{};
+            u64 gpuSize{};
+            std::list<ResourceId>::iterator lruIt{};
+        };
+
+        std::unordered_map<ResourceId, CacheEntry> m_cache{};
+        std::list<ResourceId> m_lruList{};  // Front is the most-recently used
+
+        ResourceCacheBudget m_budget{};
+        ResourceCacheStats m_stats{};
+    };
+
+    /*
+        Resource cache storing its resources by value, in a `ResourcePool`, rather than individually allocated.
+        Loaded resources are moved in from their factory, so iterating every resource of a type touches contiguous memory.
+    */
+    template <IsResourceType T>
+    class TypedResourceCache final : public ResourceCache
+    {
+    public:
+        explicit TypedResourceCache() = default;
+        ~TypedResourceCache() override = default;
+
+        DISABLE_COPY_AND_MOVE(TypedResourceCache);
+
+        /* Calls `func` with each cached resource, as a `T&`. */
+        template <typename Func>
+        void for_each(Func&& func)
+        {
+            m_pool.for_each(std::forward<Func>(func));
+        }
+
+    protected:
+        auto store(Owned<Resource> resource) -> u32 override
+        {
+            return m_pool.emplace(std::move(cast(*resource)));
+        }
+
+        auto get_stored(u32 index) -> Resource* override
+        {
+            return &m_pool.get(index);
+        }
+
+        auto extract_stored(u32 index) -> Owned<Resource> override
+        {
+            return CreateOwned<T>(m_pool.extract(index));
+        }
+
+        auto exchange_stored(u32 index, Owned<Resource> resource) -> Owned<Resource> override
+        {
+            return CreateOwned<T>(m_pool.exchange(index, std::move(cast(*resource))));
+        }
+
+    private:
+        static auto cast(Resource& resource) -> T&
+        {
+            ASSERT(resource.get_type_id() == get_resource_type_id<T>());
+            return static_cast<T&>(resource);
+        }
 
     private:
-        std::unordered_map<ResourceId, Owned<Resource>> m_cache{};
+        ResourcePool<T> m_pool{};
     };
 
-}
\ No newline at end of file
+}
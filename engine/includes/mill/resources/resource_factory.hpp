@@ -2,18 +2,61 @@
 
 #include "mill/resources/resource.hpp"
 
+#include <span>
+#include <cstddef>
+
 namespace mill
 {
     struct ResourceMetadata;
 
     struct ResourceFactory
     {
-        virtual auto load(const ResourceMetadata& metadata) -> Owned<Resource> = 0;
+        virtual ~ResourceFactory() = default;
+
+        /*
+            Called on a resource loader thread. Must not touch the RHI.
+            `data` is the resources slice of its memory-mapped data bank (or its decompressed copy, if compressed), which stays valid
+            until `on_loaded()` has returned.
+        */
+        virtual auto load(const ResourceMetadata& metadata, std::span<const std::byte> data) -> Owned<Resource> = 0;
+
+        /* Called on the main thread once `load()` has completed, before the resource is made available. */
+        virtual void on_loaded(Resource& /*resource*/) {}
+
+        /*
+            Called on the main thread each tick after `on_loaded()`, until it returns true. The resource is only made available once it
+            does, eg. once the GPU uploads started by `on_loaded()` have completed.
+        */
+        virtual bool is_ready(const Resource& /*resource*/) { return true; }
+        /* Blocks until `is_ready()` would return true. Used when a resource has to be loaded immediately. */
+        virtual void wait_until_ready(const Resource& /*resource*/) {}
+
+        /* Called on the main thread when the resource is evicted from its cache, just before it is destroyed. */
+        virtual void on_unloaded(Resource& /*resource*/) {}
     };
 
     static const std::string g_StaticMeshHeader = "msm";
+    /*
+        Static mesh binary format versions:
+        0 - Header, then the vertices, triangles and submeshes, each prefixed by their u64 count.
+        1 - Header and all u64 counts up-front, then the vertex, index and submesh blocks as contiguous little-endian arrays.
+            Each block starts on a `g_StaticMeshBlockAlignment` boundary, relative to the start of the resource.
+        2 - As 1, with a u32 index size (2 or 4 bytes) after the counts. Earlier versions always use 2 byte indices.
+        3 - As 2, with a u32 StaticVertexFormat after the index size, and each submesh followed by its bounds. Earlier versions
+            always use StaticVertex and have no bounds.
+        4 - As 3, with a u32 after the vertex format that is 1 if the positions are stored as their own stream. If so, the vertex
+            block is replaced by a position block followed by a block of the remaining attributes.
+        5 - As 4, with a u32 LOD count after the stream layout and a block of StaticMesh::Lod after the submeshes. A count of 0
+            means the mesh has no LODs.
+    */
+    constexpr u16 g_StaticMeshFormatVersion = 5;
+    constexpr u64 g_StaticMeshBlockAlignment = 16;
     struct StaticMeshFactory : public ResourceFactory
     {
-        auto load(const ResourceMetadata& metadata) -> Owned<Resource> override;
+        auto load(const ResourceMetadata& metadata, std::span<const std::byte> data) -> Owned<Resource> override;
+        void on_loaded(Resource& resource) override;
+        bool is_ready(const Resource& resource) override;
+        void wait_until_ready(const Resource& resource) override;
+        void on_unloaded(Resource& resource) override;
     };
-}
\ No newline at end of file
+}
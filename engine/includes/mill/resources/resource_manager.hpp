@@ -4,17 +4,31 @@
 #include "resource.hpp"
 #include "resource_cache.hpp"
 #include "resource_factory.hpp"
+#include "resource_registry.hpp"
+#include "mill/io/mapped_file.hpp"
+#include "mill/io/file_watcher.hpp"
+#include "mill/io/trace_writer.hpp"
 
 #include <set>
+#include <span>
 #include <queue>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
 #include <filesystem>
 namespace fs = std::filesystem;
 #include <unordered_map>
+#include <condition_variable>
 
 namespace mill
 {
     class ResourceManager;
 
+    /*
+        Reference to a managed resource. Copying or moving a handle is cheap; the reference count lives in the resources metadata.
+        When the last handle to a resource is released, the resource manager is notified and may unload it.
+    */
     class ResourceHandle
     {
     public:
@@ -23,14 +37,20 @@ namespace mill
         explicit ResourceHandle(Resource* resource);
         ResourceHandle(const ResourceHandle& other);
         ResourceHandle(ResourceHandle&& other) noexcept;
-        ~ResourceHandle() = default;
+        ~ResourceHandle();
+
+        /* Releases the reference held by this handle, leaving it empty. */
+        void reset();
 
         /* Getters */
 
-        template <typename T>
+        auto get_id() const -> ResourceId;
+
+        /* Returns nullptr if the resource is not loaded, or is not a `T`. */
+        template <IsResourceType T>
         auto As() -> T*;
 
-        template <typename T>
+        template <IsResourceType T>
         auto As() const -> const T*;
 
         /* Operators */
@@ -45,16 +65,138 @@ namespace mill
         ResourceId m_id{};
         ResourceMetadata* m_metadata{ nullptr };
         Resource* m_resource{ nullptr };
-        RefCount m_refCount{};
+        ResourceSlot m_slot{};  // Last known slot of the resource, refreshed whenever it no longer resolves
+    };
+
+    /*
+        Tracks a batch of resources requested by `ResourceManager::prefetch()`, eg. for a loading screen.
+        The batch holds a handle to each of its resources, so they stay loaded for as long as the prefetch is kept alive.
+    */
+    class ResourcePrefetch
+    {
+    public:
+        /* Getters */
+
+        auto get_total_count() const -> u32;
+        auto get_loaded_count() const -> u32;
+        auto get_failed_count() const -> u32;
+
+        /* Fraction of the batch that has finished loading (or failed to), from 0 to 1. */
+        auto get_progress() const -> f32;
+        bool is_complete() const;
+
+    private:
+        std::vector<ResourceHandle> m_handles{};
+        u32 m_loadedCount{};
+        u32 m_failedCount{};
+
+        friend class ResourceManager;
+    };
+
+    /* Order in which queued resources are loaded. Requests of the same priority are loaded in the order they were made. */
+    enum class ResourceLoadPriority : u8
+    {
+        eImmediate,   // Loaded synchronously on the calling thread
+        eVisible,     // Needed on-screen as soon as possible
+        ePrefetch,    // Expected to be needed soon, eg. the next area of a level
+        eBackground,  // Speculative, only loaded once nothing more important is waiting
     };
 
     struct ResourceManagerInit
     {
         std::string resourcePath = "..\\..\\data";
+        u32 loaderThreadCount = 2;  // Number of worker threads used to load resources in the background
+        bool useRegistry = true;    // Use the compiled resource registry when present. Otherwise, metadata banks are always scanned.
+#if MILL_DEBUG
+        // Watch `resourcePath` for changed data banks/metadata and reload the affected resources. Writers must replace banks
+        // atomically (write a temporary file, then rename it over the bank), as mapped banks are never re-read in place.
+        bool hotReload = true;
+#else
+        bool hotReload = false;
+#endif
+        std::string traceFile{};  // If set, a trace of every resource load is captured to this file from initialisation. See begin_trace().
+    };
+
+    struct ResourceLoaderStats
+    {
+        u64 queueDepth{};     // Resources currently waiting to be picked up by a loader thread
+        u64 maxQueueDepth{};  // Highest queue depth seen since initialisation
+        u64 inFlightCount{};  // Resources currently being loaded by a loader thread
+        u64 loadedCount{};
+        u64 failedCount{};
+        u64 cancelledCount{};  // Queued loads dropped because every handle was released before they started
+
+        /* Time from a resource being queued to its load completing, in milliseconds. */
+        f64 totalLoadLatencyMs{};
+        f64 maxLoadLatencyMs{};
+
+        auto get_average_load_latency_ms() const -> f64
+        {
+            const auto completed_count = loadedCount + failedCount;
+            return completed_count != 0 ? totalLoadLatencyMs / static_cast<f64>(completed_count) : 0.0;
+        }
+    };
+
+    struct ResourceTypeStats
+    {
+        ResourceCacheStats cache{};  // Resident count & bytes, cache hits/misses
+
+        u64 pendingCount{};  // Resources queued, being loaded or waiting on their GPU upload
+        u64 loadedCount{};   // Loads completed since initialisation
+        u64 failedCount{};
+
+        /*
+            Time from a resource being queued to it being published, including its GPU upload, in milliseconds.
+            Percentiles are over the most recent loads of the type.
+        */
+        f64 averageLoadLatencyMs{};
+        f64 p50LoadLatencyMs{};
+        f64 p90LoadLatencyMs{};
+        f64 p99LoadLatencyMs{};
+        f64 maxLoadLatencyMs{};
+
+        /* Fraction of cache lookups that found the resource loaded, from 0 to 1. */
+        auto get_hit_rate() const -> f64
+        {
+            const auto lookup_count = cache.hits + cache.misses;
+            return lookup_count != 0 ? static_cast<f64>(cache.hits) / static_cast<f64>(lookup_count) : 0.0;
+        }
     };
 
     class ResourceManager
     {
+    private:
+        using LoaderClock = std::chrono::steady_clock;
+
+        /* When each stage of loading a resource finished, for stats & tracing. */
+        struct ResourceLoadTimes
+        {
+            LoaderClock::time_point queued{};
+            LoaderClock::time_point started{};   // Picked up by a loader thread
+            LoaderClock::time_point dataRead{};  // Data bank slice mapped, and decompressed
+            LoaderClock::time_point decoded{};   // Created by its factory
+            LoaderClock::time_point uploadStarted{};
+        };
+
+        /* Per-type load stats. Only the most recent latencies are kept for percentiles. Main thread only. */
+        struct ResourceTypeLoadStats
+        {
+            u64 loadedCount{};
+            u64 failedCount{};
+            f64 totalLatencyMs{};
+            f64 maxLatencyMs{};
+            std::vector<f64> recentLatenciesMs{};
+            sizet nextLatencyIndex{};
+        };
+
+        struct ResourceTypeEntry
+        {
+            ResourceTypeId id{};
+            Owned<ResourceCache> cache{ nullptr };  // Nullptr if no type has been registered at this index
+            Owned<ResourceFactory> factory{ nullptr };
+            ResourceTypeLoadStats loadStats{};
+        };
+
     public:
         explicit ResourceManager() = default;
         ~ResourceManager() = default;
@@ -66,66 +208,334 @@ namespace mill
         void initialise(const ResourceManagerInit& init);
         void shutdown();
 
-        template <typename ResourceType>
-        void register_resource_type(ResourceTypeId resource_type_id, Owned<ResourceFactory> factory);
-        // void register_factory(ResourceType resource_type, );
+        /*
+            Publishes resources that have finished loading on the loader threads, once their GPU uploads have completed, and unloads
+            resources that are no longer referenced.
+            Caches without a budget unload a resource as soon as its last handle is released. Caches with a budget keep unreferenced
+            resources resident, evicting the least-recently used once over budget.
+            Should be called once per frame.
+        */
+        void tick();
+
+        /* Resources whose metadata has the type id of `T` are loaded by `factory`, then stored in a `TypedResourceCache<T>`. */
+        template <IsResourceType T>
+        void register_resource_type(Owned<ResourceFactory> factory, const ResourceCacheBudget& budget = {});
+
+        void set_cache_budget(ResourceTypeId resource_type_id, const ResourceCacheBudget& budget);
+
+        /* Reloads a loaded resource on the loader threads. Existing handles see the new resource once it has been swapped in by tick(). */
+        void reload_resource(ResourceId id);
+
+        /*
+            Starts capturing every resource load to a Chrome trace (JSON) file, for viewing in chrome://tracing or Perfetto.
+            Each load is broken down into its queue wait, I/O (mapping & decompression), decode and GPU upload stages.
+        */
+        bool begin_trace(const fs::path& filename);
+        void end_trace();
 
         /* Getters */
 
+        bool has_metadata(ResourceId id) const;
         auto get_metadata(ResourceId id) -> ResourceMetadata&;
 
-        auto get_handle(ResourceId id, bool force_load = false) -> ResourceHandle;
+        /*
+            Returns a handle to the resource, queueing it for loading if it is not already loaded. If the resource is already queued
+            at a lower priority, it is moved up. Its queued load is cancelled if every handle to it is released before the load starts.
+        */
+        auto get_handle(ResourceId id, ResourceLoadPriority priority = ResourceLoadPriority::eVisible) -> ResourceHandle;
+
+        /*
+            Queues `ids` and everything they (transitively) depend on for loading as a single batch, ordered by data bank and offset
+            so the loader threads read each bank sequentially. Progress is updated by tick().
+        */
+        auto prefetch(std::span<const ResourceId> ids, ResourceLoadPriority priority = ResourceLoadPriority::ePrefetch)
+            -> Shared<ResourcePrefetch>;
         auto get_resource(ResourceId id) -> Resource*;
+        /* Returns nullptr if the slot is not (or no longer) occupied by a loaded resource. */
+        auto resolve_slot(ResourceSlot slot) const -> Resource*;
+
+        auto get_loader_stats() const -> ResourceLoaderStats;
+        auto get_cache_stats(ResourceTypeId resource_type_id) const -> ResourceCacheStats;
+        auto get_type_stats(ResourceTypeId resource_type_id) const -> ResourceTypeStats;
+
+        /* Calls `func` with every loaded resource of type `T`, as a `T&`. Resources are visited in storage order. */
+        template <IsResourceType T, typename Func>
+        void for_each_resource(Func&& func);
 
     private:
-        void load_all_metadata();
-        void load_metadata_file(const fs::path& filename);
+        void load_all_metadata(bool use_registry);
+        /* Thread-safe. Throws YAML::Exception if the file is not valid YAML. */
+        static auto parse_metadata_file(const fs::path& filename) -> std::vector<ResourceMetadata>;
+
+        /* Creates the runtime metadata for a resource from its compiled registry record. */
+        auto materialise_metadata(const ResourceRegistryRecord& record) -> ResourceMetadata&;
+        auto make_metadata(const ResourceRegistry& registry, const ResourceRegistryRecord& record) const -> ResourceMetadata;
+        /* Copies the description of a resource from `source`, leaving its runtime state. Returns true if its data has moved. */
+        static bool update_metadata(ResourceMetadata& metadata, const ResourceMetadata& source);
 
         /* Adds resource to queue to be loaded by worker thread. */
-        void load_resource(ResourceId id);
+        void load_resource(ResourceId id, ResourceLoadPriority priority);
+        /* Adds the resources to the load queue together, in the given order. */
+        void load_resources(std::span<const ResourceId> ids, ResourceLoadPriority priority, bool is_reload = false);
+        /* Removes the resource from the load queue, if it has not started loading yet. Returns true if it was removed. */
+        bool cancel_load(ResourceId id);
+
+        /* Returns `ids` and all of their dependencies, without duplicates. */
+        auto get_dependency_closure(std::span<const ResourceId> ids) -> std::vector<ResourceId>;
+        /* Updates any prefetches waiting on the resource. */
+        void complete_prefetches(ResourceId id, bool loaded);
 
         /* Loads immediately on current thread. */
         void force_load_resource(ResourceId id);
 
+        /* Returns the memory mapping of a data bank, mapping it the first time it is requested. Thread-safe. */
+        auto get_data_bank(const std::string& filename) -> Shared<MappedFile>;
+        /*
+            Drops the mapping of a data bank, so it is re-mapped with its current contents the next time it is needed. Thread-safe.
+            Loads already using the old mapping keep it alive until their resource has been handed to its factory's on_loaded().
+        */
+        void release_data_bank(const fs::path& filename);
+
+        /*
+            Runs the resources factory on its data bank slice. Safe to call from the loader threads.
+            The resource may reference the mapped `data_bank`, or `decompressed_data` if it was compressed, so both must be kept alive
+            until the factory's on_loaded() has been called.
+        */
+        auto load_resource_data(const ResourceMetadata& metadata,
+                                Shared<MappedFile>& data_bank,
+                                std::vector<std::byte>& decompressed_data,
+                                ResourceLoadTimes& times) -> Owned<Resource>;
+        /* Adds a loaded resource, that its factory reports as ready, to its cache. Main thread only. */
+        void publish_resource(ResourceMetadata& metadata, Owned<Resource> resource);
+        /* Publishes (or swaps in, if reloaded) the resources whose GPU uploads have completed since the previous tick. Main thread only. */
+        void publish_uploaded_resources();
+        /* Swaps a ready reloaded resource in place of the currently loaded one. Main thread only. */
+        void replace_resource(ResourceMetadata& metadata, Owned<Resource> resource);
+
+        /* Hot-reload */
+
+        void process_file_changes();
+        /* Each returns false if the change cannot be applied yet, because resources it affects are being loaded. */
+        bool reload_registry();
+        bool reload_metadata_file(const fs::path& filename);
+        void reload_data_bank(const fs::path& filename);
+
+        /* Called by `ResourceHandle` when the last reference to a resource is released. Thread-safe. */
+        void on_last_reference_released(ResourceId id);
+        /* Unloads resources whose last reference was released since the previous tick, unless they have been referenced again. */
+        void unload_released_resources();
+        /* Removes the resource from its cache and destroys it. Main thread only. */
+        void unload_resource(ResourceMetadata& metadata, ResourceCache& cache);
+
+        auto allocate_slot(Resource* resource) -> ResourceSlot;
+        void free_slot(ResourceSlot slot);
+
+        /* Stats & Tracing */
+
+        /* Adds the queue wait, I/O & decode stages of a load to the trace. */
+        void trace_load(const ResourceMetadata& metadata, const ResourceLoadTimes& times, u32 thread_id);
+        /* Adds the upload stage of a load to the trace, and the load to its types stats. Main thread only. */
+        void record_load(const ResourceMetadata& metadata, const ResourceLoadTimes& times, bool loaded, bool is_reload);
+
+        /* Returns nullptr if the type has not been registered. */
+        auto find_resource_type(ResourceTypeId resource_type_id) -> ResourceTypeEntry*;
+        auto find_resource_type(ResourceTypeId resource_type_id) const -> const ResourceTypeEntry*;
+
+        /* Evicts the least-recently used resources, that are not referenced or marked `eKeepLoaded`, from caches that are over budget. */
+        void evict_resources();
+
+        void start_loader_threads(u32 thread_count);
+        void stop_loader_threads();
+        void loader_thread_func(u32 thread_id);
+
     private:
+        struct ResourceLoadRequest
+        {
+            ResourceId id{};
+            const ResourceMetadata* metadata{ nullptr };  // Map nodes are stable, so this stays valid while metadata is added
+            LoaderClock::time_point queuedTime{};
+            bool isReload{ false };
+            ResourceLoadPriority priority{};
+            u64 sequence{};  // Orders requests of the same priority, and identifies the current request for a resource
+        };
+
+        struct ResourceLoadRequestCompare
+        {
+            /* std::priority_queue pops the greatest element, so "less" means "loaded later". */
+            bool operator()(const ResourceLoadRequest& lhs, const ResourceLoadRequest& rhs) const
+            {
+                if (lhs.priority != rhs.priority)
+                {
+                    return lhs.priority > rhs.priority;
+                }
+                return lhs.sequence > rhs.sequence;
+            }
+        };
+
+        struct CompletedResourceLoad
+        {
+            ResourceId id{};
+            Owned<Resource> resource{ nullptr };
+            Shared<MappedFile> dataBank{ nullptr };      // Backs the resource until on_loaded(), even if the bank is released
+            std::vector<std::byte> decompressedData{};  // Backs the resource until on_loaded(), if it was compressed
+            bool isReload{ false };
+            ResourceLoadTimes times{};
+        };
+
+        struct UploadingResource
+        {
+            ResourceId id{};
+            Owned<Resource> resource{ nullptr };
+            bool isReload{ false };
+            ResourceLoadTimes times{};
+        };
+
         fs::path m_resourcePath;
 
+        /*
+            When a compiled registry is present, metadata is only added to `m_metadataMap` the first time a resource is requested.
+            Otherwise every metadata bank is parsed into it up-front.
+        */
+        Owned<ResourceRegistry> m_registry{ nullptr };
         std::unordered_map<ResourceId, ResourceMetadata> m_metadataMap{};
-        std::unordered_map<ResourceTypeId, Owned<ResourceCache>> m_resourceCaches{};
-        std::unordered_map<ResourceTypeId, Owned<ResourceFactory>> m_resourceFactories{};
+
+        /*
+            Registered resource types, indexed by `get_resource_type_index<T>()` so typed lookups need no hashing.
+            Resources are only known by their metadatas type id, which `m_resourceTypeIndices` maps to its index.
+            Both are filled in before any loads are queued, so the loader threads read them without locking.
+        */
+        std::vector<ResourceTypeEntry> m_resourceTypes{};
+        std::unordered_map<ResourceTypeId, u32> m_resourceTypeIndices{};
+
+        /*
+            Dense table of every loaded resource, so handles can resolve their resource without any map lookups.
+            Slots are recycled when a resource is unloaded, bumping their generation so stale handles no longer resolve.
+        */
+        struct ResourceSlotEntry
+        {
+            Resource* resource{ nullptr };
+            u32 generation{};
+        };
+        std::vector<ResourceSlotEntry> m_slots{};
+        std::vector<u32> m_freeSlots{};
+
+        /* Watches the resource path for hot-reloading. Changes that can not be applied yet are retried on the next tick. */
+        Owned<FileWatcher> m_fileWatcher{ nullptr };
+        std::vector<fs::path> m_deferredFileChanges{};
+
+        /* Data banks are mapped once and shared by every resource stored in them. */
+        std::mutex m_dataBankMutex{};
+        std::unordered_map<std::string, Shared<MappedFile>> m_dataBanks{};
+
+        /* Guards the load queue, pending set, completed loads and loader stats. */
+        mutable std::mutex m_loaderMutex{};
+        std::condition_variable m_loaderCondition{};
+        std::vector<std::thread> m_loaderThreads{};
+        bool m_stopLoaderThreads{ false };
 
         std::set<ResourceId> m_pendingResources{};  // ResourceIds of any resource waiting to load or in the process of being loaded.
-        std::queue<ResourceId> m_resourceLoadQueue{};
+        /*
+            Re-prioritised and cancelled requests are left in the queue and skipped when popped. `m_queuedLoads` holds the current
+            request of each resource that has not started loading yet.
+        */
+        std::priority_queue<ResourceLoadRequest, std::vector<ResourceLoadRequest>, ResourceLoadRequestCompare> m_resourceLoadQueue{};
+        std::unordered_map<ResourceId, ResourceLoadRequest> m_queuedLoads{};
+        u64 m_nextLoadSequence{};
+        std::vector<CompletedResourceLoad> m_completedLoads{};  // Loaded on a loader thread, waiting to be published by tick()
+        /* Loaded resources waiting on their factory to report them as ready (eg. their GPU uploads to complete). Main thread only. */
+        std::vector<UploadingResource> m_uploadingResources{};
+        ResourceLoaderStats m_loaderStats{};
+
+        /* Prefetches waiting on each resource to finish loading. Not owning, so dropping a prefetch releases (and cancels) its batch. */
+        std::unordered_map<ResourceId, std::vector<std::weak_ptr<ResourcePrefetch>>> m_prefetchWaiters{};
+
+        /* Resources whose last reference has been released, waiting to be unloaded by tick(). */
+        std::mutex m_releasedMutex{};
+        std::vector<ResourceId> m_releasedResources{};
+
+        TraceWriter m_trace{};
+
+        friend class ResourceHandle;
     };
 
-    template <typename ResourceType>
-    void mill::ResourceManager::register_resource_type(ResourceTypeId resource_type_id, Owned<ResourceFactory> factory)
+    template <IsResourceType T>
+    void ResourceManager::register_resource_type(Owned<ResourceFactory> factory, const ResourceCacheBudget& budget)
     {
-        m_resourceCaches[resource_type_id] = CreateOwned<ResourceCache>();
-        m_resourceFactories[resource_type_id] = std::move(factory);
+        ASSERT(factory != nullptr);
+
+        const auto type_id = get_resource_type_id<T>();
+        const auto type_index = get_resource_type_index<T>();
+        ASSERT(!m_resourceTypeIndices.contains(type_id) || m_resourceTypeIndices.at(type_id) == type_index);  // Type id collision
+
+        if (type_index >= m_resourceTypes.size())
+        {
+            m_resourceTypes.resize(type_index + 1);
+        }
+
+        auto& resource_type = m_resourceTypes[type_index];
+        resource_type.id = type_id;
+        resource_type.cache = CreateOwned<TypedResourceCache<T>>();
+        resource_type.cache->set_budget(budget);
+        resource_type.factory = std::move(factory);
+        m_resourceTypeIndices[type_id] = type_index;
     }
 
-    template <typename T>
+    template <IsResourceType T, typename Func>
+    void ResourceManager::for_each_resource(Func&& func)
+    {
+        const auto type_index = get_resource_type_index<T>();
+        ASSERT(type_index < m_resourceTypes.size() && m_resourceTypes[type_index].cache != nullptr);
+
+        auto& cache = static_cast<TypedResourceCache<T>&>(*m_resourceTypes[type_index].cache);
+        cache.for_each(std::forward<Func>(func));
+    }
+
+    inline auto ResourceManager::resolve_slot(ResourceSlot slot) const -> Resource*
+    {
+        if (slot.index >= m_slots.size())
+        {
+            return nullptr;
+        }
+
+        const auto& entry = m_slots[slot.index];
+        return entry.generation == slot.generation ? entry.resource : nullptr;
+    }
+
+    template <IsResourceType T>
     inline auto ResourceHandle::As() -> T*
     {
         Resource* resource{ nullptr };
+        ResourceTypeId type_id{};
         if (m_manager != nullptr && m_id)
         {
-            resource = m_manager->get_resource(m_id);
+            resource = m_manager->resolve_slot(m_slot);
+            if (resource == nullptr)
+            {
+                // Slow path: The resource has not been resolved yet, or was unloaded/reloaded since
+                resource = m_manager->get_resource(m_id);
+                m_slot = m_metadata->slot;
+            }
+            type_id = m_metadata->typeId;
         }
         else if (m_resource != nullptr)
         {
             resource = m_resource;
+            type_id = m_resource->get_type_id();
+        }
+
+        if (resource == nullptr)
+        {
+            return nullptr;
         }
 
-        auto* cast_resource = static_cast<T*>(resource);
-        return cast_resource;
+        ASSERT(type_id == get_resource_type_id<T>());
+        return type_id == get_resource_type_id<T>() ? static_cast<T*>(resource) : nullptr;
     }
 
-    template <typename T>
+    template <IsResourceType T>
     inline auto ResourceHandle::As() const -> const T*
     {
-        return As<T>();
+        return const_cast<ResourceHandle*>(this)->As<T>();
     }
 
-}
\ No newline at end of file
+}
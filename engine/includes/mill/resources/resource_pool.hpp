@@ -0,0 +1,196 @@
+#pragma once
+
+#include "mill/core/base.hpp"
+
+#include <new>
+#include <bitset>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+namespace mill
+{
+    /*
+        Stores values of a single type contiguously, in fixed-size pages so a value never moves once it has been added.
+        Removing a value leaves a hole that a later emplace() reuses, so indices stay valid until their value is removed.
+    */
+    template <typename T, u32 PageSize = 64>
+    class ResourcePool
+    {
+    public:
+        explicit ResourcePool() = default;
+        ~ResourcePool();
+
+        DISABLE_COPY_AND_MOVE(ResourcePool);
+
+        /* Returns the index of the new value. */
+        template <typename... Args>
+        auto emplace(Args&&... args) -> u32;
+        /* Removes the value at `index`, returning it. */
+        auto extract(u32 index) -> T;
+        /* Replaces the value at `index` in-place, so it keeps its address. Returns the previous value. */
+        auto exchange(u32 index, T&& value) -> T;
+        void clear();
+
+        /* Calls `func` with each value, in index order. */
+        template <typename Func>
+        void for_each(Func&& func);
+
+        /* Getters */
+
+        auto get(u32 index) -> T&;
+        auto get(u32 index) const -> const T&;
+        bool contains(u32 index) const;
+        auto get_count() const -> u32;
+
+    private:
+        struct Page
+        {
+            alignas(T) std::byte storage[sizeof(T) * PageSize];
+            std::bitset<PageSize> occupied{};
+        };
+
+        auto get_address(u32 index) const -> T*;
+
+    private:
+        std::vector<Owned<Page>> m_pages{};
+        std::vector<u32> m_freeIndices{};
+        u32 m_count{};
+    };
+
+    template <typename T, u32 PageSize>
+    ResourcePool<T, PageSize>::~ResourcePool()
+    {
+        clear();
+    }
+
+    template <typename T, u32 PageSize>
+    template <typename... Args>
+    auto ResourcePool<T, PageSize>::emplace(Args&&... args) -> u32
+    {
+        if (m_freeIndices.empty())
+        {
+            const auto first_index = CAST_U32(m_pages.size()) * PageSize;
+            m_pages.push_back(CreateOwned<Page>());
+
+            // Pushed in reverse, so the page is filled front-to-back
+            for (u32 i = PageSize; i > 0; --i)
+            {
+                m_freeIndices.push_back(first_index + i - 1);
+            }
+        }
+
+        const auto index = m_freeIndices.back();
+        std::construct_at(get_address(index), std::forward<Args>(args)...);
+        m_freeIndices.pop_back();
+        m_pages[index / PageSize]->occupied.set(index % PageSize);
+        ++m_count;
+        return index;
+    }
+
+    template <typename T, u32 PageSize>
+    auto ResourcePool<T, PageSize>::extract(u32 index) -> T
+    {
+        ASSERT(contains(index));
+
+        auto* address = get_address(index);
+        T value = std::move(*address);
+        std::destroy_at(address);
+
+        m_pages[index / PageSize]->occupied.reset(index % PageSize);
+        m_freeIndices.push_back(index);
+        --m_count;
+        return value;
+    }
+
+    template <typename T, u32 PageSize>
+    auto ResourcePool<T, PageSize>::exchange(u32 index, T&& value) -> T
+    {
+        ASSERT(contains(index));
+
+        auto* address = get_address(index);
+        T previous = std::move(*address);
+        std::destroy_at(address);
+        std::construct_at(address, std::move(value));
+        return previous;
+    }
+
+    template <typename T, u32 PageSize>
+    void ResourcePool<T, PageSize>::clear()
+    {
+        for (u32 page_index = 0; page_index < m_pages.size(); ++page_index)
+        {
+            auto& page = *m_pages[page_index];
+            for (u32 i = 0; i < PageSize && page.occupied.any(); ++i)
+            {
+                if (page.occupied.test(i))
+                {
+                    std::destroy_at(get_address(page_index * PageSize + i));
+                    page.occupied.reset(i);
+                }
+            }
+        }
+
+        m_pages.clear();
+        m_freeIndices.clear();
+        m_count = 0;
+    }
+
+    template <typename T, u32 PageSize>
+    template <typename Func>
+    void ResourcePool<T, PageSize>::for_each(Func&& func)
+    {
+        for (u32 page_index = 0; page_index < m_pages.size(); ++page_index)
+        {
+            const auto& occupied = m_pages[page_index]->occupied;
+            if (occupied.none())
+            {
+                continue;
+            }
+
+            for (u32 i = 0; i < PageSize; ++i)
+            {
+                if (occupied.test(i))
+                {
+                    func(*get_address(page_index * PageSize + i));
+                }
+            }
+        }
+    }
+
+    template <typename T, u32 PageSize>
+    auto ResourcePool<T, PageSize>::get(u32 index) -> T&
+    {
+        ASSERT(contains(index));
+        return *get_address(index);
+    }
+
+    template <typename T, u32 PageSize>
+    auto ResourcePool<T, PageSize>::get(u32 index) const -> const T&
+    {
+        ASSERT(contains(index));
+        return *get_address(index);
+    }
+
+    template <typename T, u32 PageSize>
+    bool ResourcePool<T, PageSize>::contains(u32 index) const
+    {
+        const auto page_index = index / PageSize;
+        return page_index < m_pages.size() && m_pages[page_index]->occupied.test(index % PageSize);
+    }
+
+    template <typename T, u32 PageSize>
+    auto ResourcePool<T, PageSize>::get_count() const -> u32
+    {
+        return m_count;
+    }
+
+    template <typename T, u32 PageSize>
+    auto ResourcePool<T, PageSize>::get_address(u32 index) const -> T*
+    {
+        auto& page = *m_pages[index / PageSize];
+        return std::launder(reinterpret_cast<T*>(page.storage + sizeof(T) * (index % PageSize)));
+    }
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "mill/core/base.hpp"
+#include "mill/io/mapped_file.hpp"
+#include "resource.hpp"
+
+#include <span>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace mill
+{
+    constexpr auto* g_ResourceRegistryFilename = "resources.registry";
+
+    /*
+        Compiled resource registry layout (little-endian):
+            ResourceRegistryHeader
+            ResourceRegistryRecord[recordCount]  - Sorted by id, starting at `recordsOffset`
+            ResourceId[dependencyCount]          - Every records dependencies, starting at `dependenciesOffset`
+            Data bank names[bankCount]           - Each a u32 length followed by the characters, starting at `banksOffset`
+    */
+    constexpr u32 g_ResourceRegistryMagic = 0x6772726D;  // "mrrg"
+    constexpr u32 g_ResourceRegistryVersion = 4;
+
+    struct ResourceRegistryHeader
+    {
+        u32 magic{};
+        u32 version{};
+        u32 recordCount{};
+        u32 bankCount{};
+        u64 recordsOffset{};
+        u64 banksOffset{};
+        u32 dependencyCount{};
+        u32 reserved{};
+        u64 dependenciesOffset{};
+    };
+    static_assert(sizeof(ResourceRegistryHeader) == 48);
+
+    struct ResourceRegistryRecord
+    {
+        ResourceId id{};
+        u64 binaryOffset{};
+        u64 binarySize{};
+        ResourceTypeId typeId{};
+        u16 bankIndex{};
+        u8 flags{};
+        CompressionCodec codec{};
+        u32 firstDependency{};  // Index into the registries dependency table
+        u32 dependencyCount{};
+        u64 uncompressedSize{};
+    };
+    static_assert(sizeof(ResourceRegistryRecord) == 48);
+
+    /**
+     * @brief Read-only view of a compiled resource registry. The file is memory-mapped and records are found by binary search,
+     * so nothing is parsed up-front.
+     */
+    class ResourceRegistry
+    {
+    public:
+        explicit ResourceRegistry(const std::filesystem::path& filename);
+        ~ResourceRegistry() = default;
+
+        DISABLE_COPY_AND_MOVE(ResourceRegistry);
+
+        /* Writes a registry for `resources`. Each `binaryFile` is stored as given, so should be relative to the registry. */
+        static bool write(const std::filesystem::path& filename, std::span<const ResourceMetadata> resources);
+
+        /* Getters */
+
+        bool is_valid() const;
+
+        auto find(ResourceId id) const -> const ResourceRegistryRecord*;
+        auto get_records() const -> std::span<const ResourceRegistryRecord>;
+        auto get_dependencies(const ResourceRegistryRecord& record) const -> std::span<const ResourceId>;
+        auto get_bank_name(u16 bank_index) const -> const std::string&;
+
+    private:
+        MappedFile m_file;
+        bool m_isValid{ false };
+
+        std::span<const ResourceRegistryRecord> m_records{};
+        std::span<const ResourceId> m_dependencies{};
+        std::vector<std::string> m_bankNames{};
+    };
+}
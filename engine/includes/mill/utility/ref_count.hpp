@@ -2,70 +2,49 @@
 
 #include "mill/core/base.hpp"
 
+#include <atomic>
+
 namespace mill
 {
+    /*
+        Intrusive, thread-safe reference count. Meant to be embedded in the object being referenced.
+        References belong to the object they count, so copying the object does not copy its references.
+    */
     class RefCount
     {
     public:
-        RefCount() : m_count(new u32(1)) {}
-        RefCount(const RefCount& other) : m_count(other.m_count)
-        {
-            if (m_count != nullptr)
-            {
-                ++(*m_count);
-            }
-        }
-        RefCount(RefCount&& other) noexcept
+        RefCount() = default;
+        RefCount(const RefCount& /*other*/) {}
+        ~RefCount() = default;
+
+        void add_ref()
         {
-            std::swap(m_count, other.m_count);
+            m_count.fetch_add(1, std::memory_order_relaxed);
         }
-        ~RefCount()
+
+        /* Returns true if this released the last reference. */
+        bool release()
         {
-            if (m_count)
-            {
-                --(*m_count);
-                if (*m_count == 0)
-                {
-                    delete m_count;
-                }
-            }
+            const auto prev_count = m_count.fetch_sub(1, std::memory_order_acq_rel);
+            ASSERT(prev_count != 0);
+            return prev_count == 1;
         }
 
         /* Getters */
 
         auto get_count() const -> u32
         {
-            return *m_count;
+            return m_count.load(std::memory_order_acquire);
         }
 
         /* Operators */
 
-        auto operator=(const RefCount& rhs) -> RefCount&
-        {
-            if (m_count != nullptr)
-            {
-                --(*m_count);
-                if (*m_count == 0)
-                {
-                    delete m_count;
-                }
-            }
-
-            m_count = rhs.m_count;
-            if (m_count != nullptr)
-            {
-                ++(*m_count);
-            }
-            return *this;
-        }
-
-        auto operator=(RefCount&& rhs) noexcept -> RefCount&
+        auto operator=(const RefCount& /*rhs*/) -> RefCount&
         {
-            std::swap(m_count, rhs.m_count);
             return *this;
         }
 
     private:
-        u32* m_count{ nullptr };
+        std::atomic<u32> m_count{ 0 };
     };
-}
\ No newline at end of file
+}
@@ -115,6 +115,8 @@ namespace mill
             m_pimpl->input->new_frame();
             // m_pimpl->window->poll_events();
 
+            m_pimpl->resources->tick();
+
             m_pimpl->sceneManager->tick(m_pimpl->deltaTime);
 
             // Print delta time
@@ -249,7 +251,7 @@ namespace mill
         ResourceManagerInit resource_manager_init{};
         INIT_SYSTEM(resources, CreateOwned<ResourceManager>(), resource_manager_init);
 
-        m_pimpl->resources->register_resource_type<StaticMesh>(ResourceType_StaticMesh, std::move(CreateOwned<StaticMeshFactory>()));
+        m_pimpl->resources->register_resource_type<StaticMesh>(CreateOwned<StaticMeshFactory>());
 
         INIT_SYSTEM(sceneManager, CreateOwned<SceneManager>());
 
@@ -4,6 +4,7 @@
 #include "../vulkan_device.hpp"
 #include "../vulkan_includes.hpp"
 
+#include <array>
 #include <tuple>
 
 namespace mill::rhi
@@ -40,6 +41,14 @@ namespace mill::rhi
         buffer_info.setSize(m_size);
         buffer_info.setUsage(m_usage);
 
+        // Buffers written by the upload queue are used by both the transfer & graphics queues
+        const std::array queue_families{ CAST_U32(m_device.get_graphics_queue_family()), CAST_U32(m_device.get_transfer_queue_family()) };
+        if ((m_usage & vk::BufferUsageFlagBits::eTransferDst) && queue_families[0] != queue_families[1])
+        {
+            buffer_info.setSharingMode(vk::SharingMode::eConcurrent);
+            buffer_info.setQueueFamilyIndices(queue_families);
+        }
+
         vma::AllocationCreateInfo alloc_info{};
         alloc_info.setUsage(m_memUsage);
         alloc_info.setFlags(m_allocFlags);
@@ -5,6 +5,9 @@
 #include "../vulkan_helpers.hpp"
 #include "../vulkan_includes.hpp"
 
+#include <vector>
+#include <algorithm>
+
 namespace mill::rhi
 {
     PipelineModuleVertexInput::PipelineModuleVertexInput(DeviceVulkan& device) : PipelineModule(device) {}
@@ -39,19 +42,24 @@ namespace mill::rhi
 
     auto PipelineModuleVertexInput::build_impl() -> vk::UniquePipeline
     {
-        u32 stride = 0;
+        // A binding per vertex buffer, each as wide as its interleaved attributes
+        std::vector<vk::VertexInputBindingDescription> bindings{};
         for (const auto& attribute : m_attributes)
-            stride += vulkan::get_format_byte_size(attribute.format);
-
-        vk::VertexInputBindingDescription binding{};
-        binding.setBinding(0);
-        binding.setInputRate(vk::VertexInputRate::eVertex);
-        binding.setStride(stride);
+        {
+            auto it = std::ranges::find(bindings, attribute.binding, &vk::VertexInputBindingDescription::binding);
+            if (it == bindings.end())
+            {
+                auto& binding = bindings.emplace_back();
+                binding.setBinding(attribute.binding);
+                binding.setInputRate(vk::VertexInputRate::eVertex);
+                it = bindings.end() - 1;
+            }
+            it->stride += vulkan::get_format_byte_size(attribute.format);
+        }
 
         vk::PipelineVertexInputStateCreateInfo vertex_input_state{};
         vertex_input_state.setVertexAttributeDescriptions(m_attributes);
-        if (!m_attributes.empty())
-            vertex_input_state.setVertexBindingDescriptions(binding);
+        vertex_input_state.setVertexBindingDescriptions(bindings);
 
         vk::PipelineInputAssemblyStateCreateInfo input_assembly_state{};
         input_assembly_state.setTopology(m_topology);
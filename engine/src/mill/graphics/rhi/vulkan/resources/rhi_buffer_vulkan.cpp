@@ -27,7 +27,7 @@ namespace mill::rhi
         switch (mem_usage)
         {
             case MemoryUsage::eHost: return vma::MemoryUsage::eAutoPreferHost;
-            case MemoryUsage::eDevice:
+            case MemoryUsage::eDevice: return vma::MemoryUsage::eAutoPreferDevice;
             case MemoryUsage::eDeviceHostVisble: return vma::MemoryUsage::eAutoPreferHost;
             default: ASSERT(("Unknown MemoryUsage!", false)); break;
         }
@@ -42,6 +42,8 @@ namespace mill::rhi
         out_desc.memoryUsage = to_vulkan(in_desc.memoryUsage);
         if (in_desc.memoryUsage == MemoryUsage::eDeviceHostVisble)
             out_desc.allocFlags |= vma::AllocationCreateFlagBits::eHostAccessSequentialWrite;
+        if (in_desc.memoryUsage == MemoryUsage::eDevice)
+            out_desc.usage |= vk::BufferUsageFlagBits::eTransferDst;
         return out_desc;
     }
 
@@ -60,6 +62,27 @@ namespace mill::rhi
         device.write_buffer(buffer_id, offset, size, data);
     }
 
+    auto upload_buffer(HandleBuffer buffer_id, u64 offset, u64 size, const void* data) -> UploadTicket
+    {
+        auto& device = get_device();
+
+        return device.upload_buffer(buffer_id, offset, size, data);
+    }
+
+    bool is_upload_complete(UploadTicket ticket)
+    {
+        auto& device = get_device();
+
+        return device.is_upload_complete(ticket);
+    }
+
+    void wait_for_upload(UploadTicket ticket)
+    {
+        auto& device = get_device();
+
+        device.wait_for_upload(ticket);
+    }
+
     void destroy_buffer(u64 buffer_id)
     {
         auto& device = get_device();
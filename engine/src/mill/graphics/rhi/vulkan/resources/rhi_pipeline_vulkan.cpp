@@ -45,13 +45,19 @@ namespace mill::rhi
     {
         std::vector<vk::VertexInputAttributeDescription> out_attributes{};
 
+        // Each binding's attributes are interleaved, so offsets are tracked per binding
+        std::vector<u32> binding_offsets{};
         u32 location = 0;
-        u32 offset = 0;
         for (auto& attribute : attributes)
         {
+            if (attribute.binding >= binding_offsets.size())
+                binding_offsets.resize(attribute.binding + 1, 0);
+
+            auto& offset = binding_offsets[attribute.binding];
+
             auto& out_attribute = out_attributes.emplace_back();
             out_attribute.setFormat(to_vulkan(attribute.format));
-            out_attribute.setBinding(0);
+            out_attribute.setBinding(attribute.binding);
             out_attribute.setLocation(location);
             out_attribute.setOffset(offset);
 
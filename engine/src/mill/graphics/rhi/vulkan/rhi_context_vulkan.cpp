@@ -108,14 +108,24 @@ namespace mill::rhi
         context->set_index_buffer(buffer_id, vk_index_type);
     }
 
-    void set_vertex_buffer(u64 context_id, HandleBuffer buffer_id)
+    void set_vertex_buffer(u64 context_id, HandleBuffer buffer_id, u32 binding)
     {
         auto& device = get_device();
 
         auto* context = device.get_context(context_id);
         ASSERT(context != nullptr);
 
-        context->set_vertex_buffer(buffer_id);
+        context->set_vertex_buffers(std::span(&buffer_id, 1), binding);
+    }
+
+    void set_vertex_buffers(u64 context_id, std::span<const HandleBuffer> buffer_ids, u32 first_binding)
+    {
+        auto& device = get_device();
+
+        auto* context = device.get_context(context_id);
+        ASSERT(context != nullptr);
+
+        context->set_vertex_buffers(buffer_ids, first_binding);
     }
 
     void set_resource_sets(u64 context_id, const std::vector<u64>& resource_set_ids)
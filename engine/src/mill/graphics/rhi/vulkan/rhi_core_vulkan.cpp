@@ -6,6 +6,7 @@
 #include "vulkan_screen.hpp"
 #include "vulkan_context.hpp"
 #include "vulkan_image.hpp"
+#include "vulkan_upload_queue.hpp"
 
 #include <unordered_map>
 
@@ -78,6 +79,10 @@ namespace mill::rhi
 
         std::unordered_map<u64, vk::Semaphore> present_wait_semaphore_map{};
 
+        // One transfer submission per frame for everything uploaded during it
+        g_Device->submit_uploads();
+        auto& upload_queue = g_Device->get_upload_queue();
+
         // Submit
         const auto& contexts = g_Device->get_all_contexts();
         for (auto* context : contexts)
@@ -86,6 +91,8 @@ namespace mill::rhi
                 continue;
 
             std::vector<vk::Semaphore> wait_semaphores{};
+            std::vector<vk::PipelineStageFlags> wait_stages{};
+            std::vector<u64> wait_values{};  // Only used by timeline semaphores
             for (auto& screen_id : context->get_associated_screen_ids())
             {
                 auto* screen = g_Device->get_screen(screen_id);
@@ -95,15 +102,29 @@ namespace mill::rhi
 
                 auto& semaphore = screen->get_acquire_semaphore();
                 wait_semaphores.push_back(semaphore);
+                wait_stages.push_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+                wait_values.push_back(0);
 
                 present_wait_semaphore_map[screen_id] = context->get_completed_semaphore();
             }
 
-            vk::PipelineStageFlags wait_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+            // Uploads are only used once they have been seen to complete, which this wait never blocks on. It makes the uploaded
+            // data visible to this submission.
+            if (upload_queue.get_completed_ticket() != 0)
+            {
+                wait_semaphores.push_back(upload_queue.get_semaphore());
+                wait_stages.push_back(vk::PipelineStageFlagBits::eVertexInput);
+                wait_values.push_back(upload_queue.get_completed_ticket());
+            }
+
+            vk::TimelineSemaphoreSubmitInfo timeline_info{};
+            timeline_info.setWaitSemaphoreValues(wait_values);
+
             vk::SubmitInfo submit_info{};
             submit_info.setCommandBuffers(context->get_cmd());
-            submit_info.setWaitDstStageMask(wait_stage);
             submit_info.setWaitSemaphores(wait_semaphores);
+            submit_info.setWaitDstStageMask(wait_stages);
+            submit_info.setPNext(&timeline_info);
             if (can_present)
                 submit_info.setSignalSemaphores(context->get_completed_semaphore());
             queue.submit(submit_info, context->get_fence());
@@ -77,9 +77,11 @@ namespace mill::rhi
             case mill::rhi::Format::eR8: return vk::Format::eR8Unorm;
             case mill::rhi::Format::eR16: return vk::Format::eR16Unorm;
             case mill::rhi::Format::eR32: return vk::Format::eR32Uint;
+            case mill::rhi::Format::eRG16F: return vk::Format::eR16G16Sfloat;
             case mill::rhi::Format::eRG32: return vk::Format::eR32G32Sfloat;
             case mill::rhi::Format::eRGB32: return vk::Format::eR32G32B32Sfloat;
             case mill::rhi::Format::eRGBA8: return vk::Format::eR8G8B8A8Unorm;
+            case mill::rhi::Format::eRGBA16Unorm: return vk::Format::eR16G16B16A16Unorm;
             case mill::rhi::Format::eD16: return vk::Format::eD16Unorm;
             case mill::rhi::Format::eD24S8: return vk::Format::eD24UnormS8Uint;
             case mill::rhi::Format::eD32: return vk::Format::eD32Sfloat;
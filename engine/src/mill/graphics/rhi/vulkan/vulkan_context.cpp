@@ -11,6 +11,8 @@
 #include "vulkan_image.hpp"
 #include "vulkan_helpers.hpp"
 
+#include <array>
+
 namespace mill::rhi
 {
     ContextVulkan::ContextVulkan(DeviceVulkan& device) : m_device(device)
@@ -161,12 +163,21 @@ namespace mill::rhi
         get_frame().wasRecorded = true;
     }
 
-    void ContextVulkan::set_vertex_buffer(HandleBuffer buffer_id)
+    void ContextVulkan::set_vertex_buffers(std::span<const HandleBuffer> buffer_ids, u32 first_binding)
     {
-        ASSERT(buffer_id);
-        const auto& buffer = m_device.get_buffer(buffer_id);
+        ASSERT(!buffer_ids.empty());
+        ASSERT(buffer_ids.size() <= g_MaxVertexBufferBindings);
+
+        // Bound for every draw, so stays on the stack
+        std::array<vk::Buffer, g_MaxVertexBufferBindings> buffers{};
+        const std::array<vk::DeviceSize, g_MaxVertexBufferBindings> offsets{};
+        for (sizet i = 0; i < buffer_ids.size(); ++i)
+        {
+            ASSERT(buffer_ids[i]);
+            buffers[i] = m_device.get_buffer(buffer_ids[i]).get_buffer();
+        }
 
-        get_cmd().bindVertexBuffers(0, buffer.get_buffer(), { 0 });
+        get_cmd().bindVertexBuffers(first_binding, CAST_U32(buffer_ids.size()), buffers.data(), offsets.data());
 
         get_frame().wasRecorded = true;
     }
@@ -5,6 +5,8 @@
 #include "rhi_resource_vulkan.hpp"
 #include "vulkan_includes.hpp"
 
+#include <span>
+
 namespace mill::rhi
 {
     class DeviceVulkan;
@@ -31,7 +33,7 @@ namespace mill::rhi
         void draw(u32 vertex_count);
 
         void set_index_buffer(HandleBuffer buffer_id, vk::IndexType index_type);
-        void set_vertex_buffer(HandleBuffer buffer_id);
+        void set_vertex_buffers(std::span<const HandleBuffer> buffer_ids, u32 first_binding);
 
         void draw_indexed(u32 index_count, u32 instance_count, u32 index_offset, u32 vertex_offset);
 
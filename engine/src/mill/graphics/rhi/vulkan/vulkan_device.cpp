@@ -19,6 +19,7 @@
 #include "resources/buffer.hpp"
 #include "resources/sampler.hpp"
 #include "vulkan_image.hpp"
+#include "vulkan_upload_queue.hpp"
 
 #define VMA_IMPLEMENTATION
 #include <vk_mem_alloc.h>
@@ -31,6 +32,7 @@ namespace mill::rhi
 {
     constexpr auto g_VulkanAPIVersion = VK_API_VERSION_1_3;
     constexpr bool g_PipelineLinkTimeOptimisation = true;  // Enable for better runtime performance (costs slower compile/linking time)
+    constexpr u64 g_UploadStagingSize = 32ull * 1024 * 1024;  // Uploads larger than this get their own staging buffer
 
     VKAPI_ATTR VkBool32 VKAPI_CALL debug_message_callback(VkDebugUtilsMessageSeverityFlagBitsEXT message_severity,
                                                           VkDebugUtilsMessageTypeFlagsEXT message_type,
@@ -73,6 +75,8 @@ namespace mill::rhi
             m_allocator = vma::createAllocatorUnique(alloc_info);
         }
 
+        m_uploadQueue = CreateOwned<UploadQueueVulkan>(*this, g_UploadStagingSize);
+
         // Descriptor Pool
         {
             std::vector<vk::DescriptorPoolSize> pool_sizes{
@@ -97,6 +101,17 @@ namespace mill::rhi
             return;
 
         wait_idle();
+
+        for (auto& deletion_queue : m_destructionQueues)
+        {
+            while (!deletion_queue.empty())
+            {
+                deletion_queue.front()();
+                deletion_queue.pop();
+            }
+        }
+
+        m_uploadQueue = nullptr;
     }
 
     void DeviceVulkan::next_frame()
@@ -511,23 +526,54 @@ namespace mill::rhi
             return;
         }
 
-        LOG_WARN("DeviceVulkan - Writing to non-HostVisible buffers is not yet supported.");
+        // Device-local buffers are written through the upload queue
+        const auto ticket = m_uploadQueue->upload_buffer(*buffer, offset, size, data);
+        m_uploadQueue->wait(ticket);
+    }
 
-        // #TODO: Staging buffer
+    auto DeviceVulkan::upload_buffer(u64 buffer_id, u64 offset, u64 size, const void* data) -> u64
+    {
+        ASSERT(m_buffers.contains(buffer_id));
+
+        const auto& buffer = m_buffers.at(buffer_id);
+        return m_uploadQueue->upload_buffer(*buffer, offset, size, data);
     }
 
     void DeviceVulkan::destroy_buffer(u64 buffer_id)
     {
         ASSERT(m_buffers.contains(buffer_id));
 
-        auto& buffer = m_buffers.at(buffer_id);
-        auto vk_buffer = buffer->get_buffer();
-        auto vk_alloc = buffer->get_allocation();
-        auto add_deletion_func([this, vk_buffer, vk_alloc]() { m_allocator->destroyBuffer(vk_buffer, vk_alloc); });
+        // The buffer may still be in use by frames in-flight, so keep it alive until this frame index comes around again
+        Shared<Buffer> buffer = std::move(m_buffers.at(buffer_id));
+        m_buffers.erase(buffer_id);
 
-        LOG_DEBUG("DeviceVulkan - Buffer being destroyed: id={}, , size={}B.", buffer_id, buffer->get_size());
+        LOG_DEBUG("DeviceVulkan - Buffer being destroyed: id={}, size={}B.", buffer_id, buffer->get_size());
 
-        m_buffers.erase(buffer_id);
+        // Uploads are not tied to frames, so also make sure any upload into the buffer has finished
+        const auto upload_ticket = m_uploadQueue->get_last_ticket();
+        add_deletion_func(
+            [this, buffer, upload_ticket]() mutable
+            {
+                m_uploadQueue->wait(upload_ticket);
+                buffer = nullptr;
+            });
+    }
+
+    /* Uploads */
+
+    void DeviceVulkan::submit_uploads()
+    {
+        m_uploadQueue->submit();
+    }
+
+    bool DeviceVulkan::is_upload_complete(u64 ticket)
+    {
+        return m_uploadQueue->is_complete(ticket);
+    }
+
+    void DeviceVulkan::wait_for_upload(u64 ticket)
+    {
+        m_uploadQueue->wait(ticket);
     }
 
     /* Samplers */
@@ -701,6 +747,12 @@ namespace mill::rhi
         return m_descriptorPool.get();
     }
 
+    auto DeviceVulkan::get_upload_queue() -> UploadQueueVulkan&
+    {
+        ASSERT(m_uploadQueue);
+        return *m_uploadQueue;
+    }
+
     bool DeviceVulkan::init_instance()
     {
         VULKAN_HPP_DEFAULT_DISPATCHER.init(m_loader.getProcAddress<PFN_vkGetInstanceProcAddr>("vkGetInstanceProcAddr"));
@@ -827,8 +879,12 @@ namespace mill::rhi
         features.setFillModeNonSolid(true);
         features.setWideLines(true);
 
+        vk::PhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features{};
+        timeline_semaphore_features.setTimelineSemaphore(true);
+
         vk::PhysicalDeviceSynchronization2Features sync2_features{};
         sync2_features.setSynchronization2(true);
+        sync2_features.setPNext(&timeline_semaphore_features);
 
         vk::PhysicalDeviceDynamicRenderingFeatures dyn_rendering_features{};
         dyn_rendering_features.setDynamicRendering(true);
@@ -27,6 +27,7 @@ namespace mill::rhi
     class Buffer;
     class Sampler;
     class ImageVulkan;
+    class UploadQueueVulkan;
 
     class DeviceVulkan
     {
@@ -87,9 +88,18 @@ namespace mill::rhi
         auto get_buffer(u64 buffer_id) -> const Buffer&;
         auto create_buffer(const BufferDescriptionVulkan& description) -> u64;
         void write_buffer(u64 buffer_id, u64 offset, u64 size, const void* data);
+        /* Queues the data to be copied into the buffer on the transfer queue. Returns a ticket to check for its completion. */
+        auto upload_buffer(u64 buffer_id, u64 offset, u64 size, const void* data) -> u64;
 
         void destroy_buffer(u64 buffer_id);
 
+        /* Uploads */
+
+        /* Submits the uploads queued this frame. */
+        void submit_uploads();
+        bool is_upload_complete(u64 ticket);
+        void wait_for_upload(u64 ticket);
+
         /* Samplers */
 
         auto get_or_create_sampler(const SamplerDescriptionVulkan& description) -> Shared<Sampler>;
@@ -119,6 +129,7 @@ namespace mill::rhi
 
         auto get_allocator() -> vma::Allocator&;
         auto get_descriptor_pool() -> vk::DescriptorPool&;
+        auto get_upload_queue() -> UploadQueueVulkan&;
 
     private:
         bool init_instance();
@@ -150,6 +161,7 @@ namespace mill::rhi
 
         vma::UniqueAllocator m_allocator{};
         vk::UniqueDescriptorPool m_descriptorPool{};
+        Owned<UploadQueueVulkan> m_uploadQueue{ nullptr };
 
         std::array<std::queue<std::function<void()>>, g_FrameBufferCount> m_destructionQueues;
         u32 m_frameIndex{};
@@ -805,6 +805,12 @@ namespace mill::rhi::vulkan
             case vk::Format::eR8G8B8Srgb: return 1 * 3;
             case vk::Format::eR8G8B8A8Unorm:
             case vk::Format::eR8G8B8A8Srgb: return 1 * 4;
+            case vk::Format::eR16Unorm:
+            case vk::Format::eR16Sfloat: return 2 * 1;
+            case vk::Format::eR16G16Unorm:
+            case vk::Format::eR16G16Sfloat: return 2 * 2;
+            case vk::Format::eR16G16B16A16Unorm:
+            case vk::Format::eR16G16B16A16Sfloat: return 2 * 4;
             case vk::Format::eR32Uint: return 4 * 1;
             case vk::Format::eR32Sfloat: return 4 * 1;
             case vk::Format::eR32G32Sfloat: return 4 * 2;
@@ -0,0 +1,262 @@
+#include "vulkan_upload_queue.hpp"
+
+#include "mill/core/base.hpp"
+#include "mill/core/debug.hpp"
+#include "vulkan_device.hpp"
+#include "vulkan_helpers.hpp"
+#include "resources/buffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace mill::rhi
+{
+    constexpr u64 g_StagingAlignment = 16;
+
+    namespace
+    {
+        auto create_staging_buffer(DeviceVulkan& device, u64 size) -> Owned<Buffer>
+        {
+            auto staging_buffer = CreateOwned<Buffer>(device);
+            staging_buffer->set_size(size);
+            staging_buffer->set_usage(vk::BufferUsageFlagBits::eTransferSrc);
+            staging_buffer->set_memory_usage(vma::MemoryUsage::eAutoPreferHost);
+            staging_buffer->set_alloc_flags(vma::AllocationCreateFlagBits::eHostAccessSequentialWrite);
+            staging_buffer->build();
+            return staging_buffer;
+        }
+    }
+
+    UploadQueueVulkan::UploadQueueVulkan(DeviceVulkan& device, u64 staging_size) : m_device(device), m_stagingSize(staging_size)
+    {
+        ASSERT(staging_size > 0);
+
+        vk::CommandPoolCreateInfo pool_info{};
+        pool_info.setQueueFamilyIndex(m_device.get_transfer_queue_family());
+        pool_info.setFlags(vk::CommandPoolCreateFlagBits::eTransient);
+        m_cmdPool = m_device.get_device().createCommandPoolUnique(pool_info);
+
+        vk::SemaphoreTypeCreateInfo semaphore_type_info{};
+        semaphore_type_info.setSemaphoreType(vk::SemaphoreType::eTimeline);
+        semaphore_type_info.setInitialValue(0);
+        vk::SemaphoreCreateInfo semaphore_info{};
+        semaphore_info.setPNext(&semaphore_type_info);
+        m_timelineSemaphore = m_device.get_device().createSemaphoreUnique(semaphore_info);
+        SET_VK_OBJECT_NAME(m_device.get_device(), VkSemaphore, m_timelineSemaphore.get(), "Upload Queue (Timeline)");
+
+        // The ring stays mapped for the lifetime of the queue
+        m_stagingBuffer = create_staging_buffer(m_device, m_stagingSize);
+        m_stagingMapped = static_cast<std::byte*>(m_device.get_allocator().mapMemory(m_stagingBuffer->get_allocation()));
+        ASSERT(m_stagingMapped);
+    }
+
+    UploadQueueVulkan::~UploadQueueVulkan()
+    {
+        wait(get_last_ticket());
+
+        m_device.get_allocator().unmapMemory(m_stagingBuffer->get_allocation());
+        m_stagingMapped = nullptr;
+    }
+
+    auto UploadQueueVulkan::upload_buffer(const Buffer& buffer, u64 offset, u64 size, const void* data) -> u64
+    {
+        ASSERT(offset + size <= buffer.get_size());
+        ASSERT(data != nullptr || size == 0);
+
+        if (size == 0)
+        {
+            return get_completed_ticket();
+        }
+
+        auto& allocator = m_device.get_allocator();
+
+        vk::BufferCopy region{};
+        region.setDstOffset(offset);
+        region.setSize(size);
+
+        vk::Buffer src_buffer{};
+        const auto staging_offset = allocate_staging(size);
+        if (staging_offset != u64_max)
+        {
+            std::memcpy(m_stagingMapped + staging_offset, data, size);
+            allocator.flushAllocation(m_stagingBuffer->get_allocation(), staging_offset, size);
+
+            src_buffer = m_stagingBuffer->get_buffer();
+            region.setSrcOffset(staging_offset);
+        }
+        else
+        {
+            LOG_DEBUG("UploadQueueVulkan - Upload of {}B is larger than the staging ring ({}B). Using a dedicated staging buffer.",
+                      size,
+                      m_stagingSize);
+
+            auto staging_buffer = create_staging_buffer(m_device, size);
+            void* mapped = allocator.mapMemory(staging_buffer->get_allocation());
+            ASSERT(mapped);
+            std::memcpy(mapped, data, size);
+            allocator.unmapMemory(staging_buffer->get_allocation());
+            allocator.flushAllocation(staging_buffer->get_allocation(), 0, VK_WHOLE_SIZE);
+
+            src_buffer = staging_buffer->get_buffer();
+            m_pendingDedicatedBuffers.push_back(std::move(staging_buffer));
+        }
+
+        m_pendingCopies.push_back({ src_buffer, buffer.get_buffer(), region });
+        return m_submittedTicket + 1;
+    }
+
+    void UploadQueueVulkan::submit()
+    {
+        retire_submissions();
+
+        if (m_pendingCopies.empty())
+        {
+            return;
+        }
+
+        vk::CommandBufferAllocateInfo alloc_info{};
+        alloc_info.setCommandPool(m_cmdPool.get());
+        alloc_info.setCommandBufferCount(1);
+        alloc_info.setLevel(vk::CommandBufferLevel::ePrimary);
+
+        Submission submission{};
+        submission.ticket = m_submittedTicket + 1;
+        submission.cmd = std::move(m_device.get_device().allocateCommandBuffersUnique(alloc_info)[0]);
+        submission.stagingBytes = std::exchange(m_pendingStagingBytes, 0);
+        submission.dedicatedStagingBuffers = std::move(m_pendingDedicatedBuffers);
+        m_pendingDedicatedBuffers.clear();
+
+        auto& cmd = submission.cmd.get();
+        vk::CommandBufferBeginInfo begin_info{};
+        begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        cmd.begin(begin_info);
+
+        // Consecutive copies between the same pair of buffers (eg. a resources vertex & index data) are recorded as one command
+        std::vector<vk::BufferCopy> regions{};
+        for (sizet i = 0; i < m_pendingCopies.size(); ++i)
+        {
+            const auto& copy = m_pendingCopies[i];
+            regions.push_back(copy.region);
+
+            const bool is_last = i + 1 == m_pendingCopies.size();
+            if (is_last || m_pendingCopies[i + 1].srcBuffer != copy.srcBuffer || m_pendingCopies[i + 1].dstBuffer != copy.dstBuffer)
+            {
+                cmd.copyBuffer(copy.srcBuffer, copy.dstBuffer, regions);
+                regions.clear();
+            }
+        }
+        cmd.end();
+
+        vk::TimelineSemaphoreSubmitInfo timeline_info{};
+        timeline_info.setSignalSemaphoreValues(submission.ticket);
+
+        vk::SubmitInfo submit_info{};
+        submit_info.setCommandBuffers(cmd);
+        submit_info.setSignalSemaphores(m_timelineSemaphore.get());
+        submit_info.setPNext(&timeline_info);
+        m_device.get_transfer_queue().submit(submit_info);
+
+        LOG_DEBUG("UploadQueueVulkan - Submitted {} uploads (ticket={}).", m_pendingCopies.size(), submission.ticket);
+
+        m_pendingCopies.clear();
+        m_submittedTicket = submission.ticket;
+        m_submissions.push_back(std::move(submission));
+    }
+
+    bool UploadQueueVulkan::is_complete(u64 ticket)
+    {
+        if (ticket <= m_completedTicket)
+        {
+            return true;
+        }
+
+        m_completedTicket = m_device.get_device().getSemaphoreCounterValue(m_timelineSemaphore.get());
+        return ticket <= m_completedTicket;
+    }
+
+    void UploadQueueVulkan::wait(u64 ticket)
+    {
+        ASSERT(ticket <= m_submittedTicket + 1);
+
+        if (!is_complete(ticket))
+        {
+            if (ticket > m_submittedTicket)
+            {
+                submit();
+            }
+
+            vk::SemaphoreWaitInfo wait_info{};
+            wait_info.setSemaphores(m_timelineSemaphore.get());
+            wait_info.setValues(ticket);
+            UNUSED(m_device.get_device().waitSemaphores(wait_info, u64_max));
+
+            m_completedTicket = std::max(m_completedTicket, ticket);
+        }
+
+        retire_submissions();
+    }
+
+    auto UploadQueueVulkan::get_last_ticket() const -> u64
+    {
+        return m_pendingCopies.empty() ? m_submittedTicket : m_submittedTicket + 1;
+    }
+
+    auto UploadQueueVulkan::get_completed_ticket() const -> u64
+    {
+        return m_completedTicket;
+    }
+
+    auto UploadQueueVulkan::get_semaphore() const -> vk::Semaphore
+    {
+        return m_timelineSemaphore.get();
+    }
+
+    auto UploadQueueVulkan::allocate_staging(u64 size) -> u64
+    {
+        size = align_up(size, g_StagingAlignment);
+        if (size > m_stagingSize)
+        {
+            return u64_max;
+        }
+
+        while (true)
+        {
+            if (m_stagingUsed == 0)
+            {
+                m_stagingHead = 0;
+            }
+
+            // Allocations never wrap around the end of the ring, so skip what is left of it if there is not enough room
+            const u64 padding = m_stagingHead + size > m_stagingSize ? m_stagingSize - m_stagingHead : 0;
+            if (m_stagingUsed + padding + size <= m_stagingSize)
+            {
+                const u64 offset = (m_stagingHead + padding) % m_stagingSize;
+                m_stagingHead = (offset + size) % m_stagingSize;
+                m_stagingUsed += padding + size;
+                m_pendingStagingBytes += padding + size;
+                return offset;
+            }
+
+            // The ring is full. Make room by waiting on the oldest submission, submitting the pending uploads first if they are filling it.
+            if (m_submissions.empty())
+            {
+                submit();
+            }
+            ASSERT(!m_submissions.empty());
+
+            LOG_DEBUG("UploadQueueVulkan - Staging ring is full. Waiting on upload ticket {}.", m_submissions.front().ticket);
+            wait(m_submissions.front().ticket);
+        }
+    }
+
+    void UploadQueueVulkan::retire_submissions()
+    {
+        while (!m_submissions.empty() && is_complete(m_submissions.front().ticket))
+        {
+            m_stagingUsed -= m_submissions.front().stagingBytes;
+            m_submissions.pop_front();
+        }
+    }
+
+}
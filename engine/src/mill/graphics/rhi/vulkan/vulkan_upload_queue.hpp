@@ -0,0 +1,87 @@
+#pragma once
+
+#include "mill/core/base.hpp"
+#include "vulkan_includes.hpp"
+
+#include <deque>
+#include <vector>
+
+namespace mill::rhi
+{
+    class DeviceVulkan;
+    class Buffer;
+
+    /*
+        Streams data into buffers on the transfer queue, so device-local buffers can be filled without stalling the caller.
+        Data is copied into a persistently mapped staging ring when an upload is queued. Every copy queued since the previous submit()
+        is recorded into one command buffer, whose submission signals the next value of a timeline semaphore. An uploads ticket is the
+        value signalled by the submission it is part of, so it has completed once the semaphore reaches it.
+    */
+    class UploadQueueVulkan
+    {
+    public:
+        explicit UploadQueueVulkan(DeviceVulkan& device, u64 staging_size);
+        ~UploadQueueVulkan();
+
+        DISABLE_COPY_AND_MOVE(UploadQueueVulkan);
+
+        /* Copies `data` to staging memory and queues its upload. Returns the uploads ticket. */
+        auto upload_buffer(const Buffer& buffer, u64 offset, u64 size, const void* data) -> u64;
+
+        /* Submits every upload queued since the previous submit. */
+        void submit();
+
+        bool is_complete(u64 ticket);
+        /* Blocks until the upload has completed, submitting it first if needed. */
+        void wait(u64 ticket);
+
+        /* Getters */
+
+        /* Ticket of the most recently queued upload. */
+        auto get_last_ticket() const -> u64;
+        /* Highest ticket the device has been seen to complete. */
+        auto get_completed_ticket() const -> u64;
+        auto get_semaphore() const -> vk::Semaphore;
+
+    private:
+        /* Returns the offset of `size` bytes in the staging ring, or u64_max if they will never fit. Waits for room if the ring is full. */
+        auto allocate_staging(u64 size) -> u64;
+        /* Frees the staging memory & command buffers of submissions that have completed. */
+        void retire_submissions();
+
+    private:
+        struct PendingCopy
+        {
+            vk::Buffer srcBuffer{};
+            vk::Buffer dstBuffer{};
+            vk::BufferCopy region{};
+        };
+
+        struct Submission
+        {
+            u64 ticket{};
+            vk::UniqueCommandBuffer cmd{};
+            u64 stagingBytes{};  // Staging ring bytes used by this submission, including any skipped at the end of the ring
+            std::vector<Owned<Buffer>> dedicatedStagingBuffers{};
+        };
+
+        DeviceVulkan& m_device;
+
+        vk::UniqueCommandPool m_cmdPool{};
+        vk::UniqueSemaphore m_timelineSemaphore{};
+        u64 m_submittedTicket{};
+        u64 m_completedTicket{};
+
+        Owned<Buffer> m_stagingBuffer{ nullptr };
+        std::byte* m_stagingMapped{ nullptr };
+        u64 m_stagingSize{};
+        u64 m_stagingHead{};  // Offset of the next staging allocation
+        u64 m_stagingUsed{};  // Bytes in use by pending & in-flight uploads
+
+        std::vector<PendingCopy> m_pendingCopies{};
+        u64 m_pendingStagingBytes{};
+        std::vector<Owned<Buffer>> m_pendingDedicatedBuffers{};  // Staging for uploads too large for the ring
+
+        std::deque<Submission> m_submissions{};  // In-flight, oldest first
+    };
+}
@@ -2,6 +2,8 @@
 
 #include "mill/graphics/rhi/resources/rhi_buffer.hpp"
 
+#include <glm/common.hpp>
+
 namespace mill
 {
     void StaticMesh::set_vertices(const std::vector<StaticVertex>& vertices)
@@ -9,18 +11,73 @@ namespace mill
         m_vertices = vertices;
     }
 
-    void StaticMesh::set_triangles(const std::vector<u16>& triangles)
+    void StaticMesh::set_indices(const std::vector<u32>& indices)
     {
-        m_triangles = triangles;
+        m_indices = indices;
     }
 
     void StaticMesh::set_submeshes(const std::vector<Submesh>& submeshes)
     {
         m_submeshes = submeshes;
+
+        m_boundsMin = {};
+        m_boundsMax = {};
+        for (sizet i = 0; i < m_submeshes.size(); ++i)
+        {
+            m_boundsMin = i == 0 ? m_submeshes[i].boundsMin : glm::min(m_boundsMin, m_submeshes[i].boundsMin);
+            m_boundsMax = i == 0 ? m_submeshes[i].boundsMax : glm::max(m_boundsMax, m_submeshes[i].boundsMax);
+        }
+    }
+
+    void StaticMesh::set_lods(const std::vector<Lod>& lods)
+    {
+        m_lods = lods;
+    }
+
+    void StaticMesh::set_vertex_data(std::span<const std::byte> vertex_data,
+                                     StaticVertexFormat vertex_format,
+                                     std::span<const std::byte> position_data)
+    {
+        m_vertexData = vertex_data;
+        m_vertexFormat = vertex_format;
+        m_positionData = position_data;
+    }
+
+    void StaticMesh::set_index_data(std::span<const std::byte> index_data, rhi::IndexType index_type)
+    {
+        m_indexData = index_data;
+        m_indexType = index_type;
     }
 
     void StaticMesh::apply()
     {
+        // Uploaded as 16-bit indices whenever possible, to halve their memory & bandwidth
+        std::vector<u16> narrowed_indices{};
+        std::span<const std::byte> index_data = m_indexData;
+        if (index_data.empty())
+        {
+            // Meshes without submeshes are drawn as a single one
+            const Submesh whole_mesh{ .indexCount = CAST_U32(m_indices.size()), .vertexCount = CAST_U32(m_vertices.size()) };
+            m_indexType = select_index_type(!m_submeshes.empty() ? std::span<const Submesh>(m_submeshes) : std::span(&whole_mesh, 1));
+            if (m_indexType == rhi::IndexType::eU16)
+            {
+                narrowed_indices.assign(m_indices.begin(), m_indices.end());
+                index_data = std::as_bytes(std::span<const u16>(narrowed_indices));
+            }
+            else
+            {
+                index_data = std::as_bytes(std::span<const u32>(m_indices));
+            }
+        }
+        std::span<const std::byte> vertex_data = m_vertexData;
+        std::span<const std::byte> position_data = m_positionData;
+        if (vertex_data.empty())
+        {
+            vertex_data = std::as_bytes(std::span<const StaticVertex>(m_vertices));
+            position_data = {};
+            m_vertexFormat = StaticVertexFormat::eFloat;
+        }
+
         // Index Buffer
         {
 #if 0
@@ -29,14 +86,15 @@ namespace mill
 #endif
 
             rhi::BufferDescription buffer_desc{
-                .size = sizeof(u16) * m_triangles.size(),
+                .size = index_data.size(),
                 .usage = rhi::BufferUsage::eIndexBuffer,
-                .memoryUsage = rhi::MemoryUsage::eDeviceHostVisble,
+                .memoryUsage = rhi::MemoryUsage::eDevice,
             };
             m_indexBuffer = rhi::create_buffer(buffer_desc);
-            rhi::write_buffer(m_indexBuffer, 0, buffer_desc.size, m_triangles.data());
+            m_indexBufferSize = buffer_desc.size;
+            m_uploadTicket = rhi::upload_buffer(m_indexBuffer, 0, buffer_desc.size, index_data.data());
         }
-        m_indexCount = CAST_U32(m_triangles.size());
+        m_indexCount = CAST_U32(index_data.size() / (m_indexType == rhi::IndexType::eU16 ? sizeof(u16) : sizeof(u32)));
 
         // Vertex Buffer
         {
@@ -46,13 +104,69 @@ namespace mill
 #endif
 
             rhi::BufferDescription buffer_desc{
-                .size = sizeof(StaticVertex) * m_vertices.size(),
+                .size = vertex_data.size(),
                 .usage = rhi::BufferUsage::eVertexBuffer,
-                .memoryUsage = rhi::MemoryUsage::eDeviceHostVisble,
+                .memoryUsage = rhi::MemoryUsage::eDevice,
             };
             m_vertexBuffer = rhi::create_buffer(buffer_desc);
-            rhi::write_buffer(m_vertexBuffer, 0, buffer_desc.size, m_vertices.data());
+            m_vertexBufferSize = buffer_desc.size;
+            m_uploadTicket = rhi::upload_buffer(m_vertexBuffer, 0, buffer_desc.size, vertex_data.data());
         }
+
+        // Position Buffer
+        if (!position_data.empty())
+        {
+            rhi::BufferDescription buffer_desc{
+                .size = position_data.size(),
+                .usage = rhi::BufferUsage::eVertexBuffer,
+                .memoryUsage = rhi::MemoryUsage::eDevice,
+            };
+            m_positionBuffer = rhi::create_buffer(buffer_desc);
+            m_positionBufferSize = buffer_desc.size;
+            m_uploadTicket = rhi::upload_buffer(m_positionBuffer, 0, buffer_desc.size, position_data.data());
+        }
+
+        // The source data is only guaranteed to be valid until now. The uploads have their own copy of it.
+        m_vertexData = {};
+        m_positionData = {};
+        m_indexData = {};
+    }
+
+    bool StaticMesh::is_uploaded() const
+    {
+        return rhi::is_upload_complete(m_uploadTicket);
+    }
+
+    void StaticMesh::wait_until_uploaded() const
+    {
+        rhi::wait_for_upload(m_uploadTicket);
+    }
+
+    void StaticMesh::release()
+    {
+        if (m_indexBuffer)
+        {
+            rhi::destroy_buffer(m_indexBuffer);
+            m_indexBuffer = {};
+            m_indexBufferSize = 0;
+        }
+
+        if (m_vertexBuffer)
+        {
+            rhi::destroy_buffer(m_vertexBuffer);
+            m_vertexBuffer = {};
+            m_vertexBufferSize = 0;
+        }
+
+        if (m_positionBuffer)
+        {
+            rhi::destroy_buffer(m_positionBuffer);
+            m_positionBuffer = {};
+            m_positionBufferSize = 0;
+        }
+
+        m_indexCount = 0;
+        m_uploadTicket = {};
     }
 
     auto StaticMesh::get_vertices() const -> const std::vector<StaticVertex>&
@@ -60,9 +174,9 @@ namespace mill
         return m_vertices;
     }
 
-    auto StaticMesh::get_indices() const -> const std::vector<u16>&
+    auto StaticMesh::get_indices() const -> const std::vector<u32>&
     {
-        return m_triangles;
+        return m_indices;
     }
 
     auto StaticMesh::get_submeshes() const -> const std::vector<Submesh>&
@@ -70,11 +184,64 @@ namespace mill
         return m_submeshes;
     }
 
+    auto StaticMesh::get_lods() const -> const std::vector<Lod>&
+    {
+        return m_lods;
+    }
+
+    auto StaticMesh::get_lod_count() const -> u32
+    {
+        return m_lods.empty() ? 1 : CAST_U32(m_lods.size());
+    }
+
+    auto StaticMesh::get_lod_submeshes(u32 lod) const -> std::span<const Submesh>
+    {
+        if (m_lods.empty())
+        {
+            ASSERT(lod == 0);
+            return m_submeshes;
+        }
+
+        ASSERT(lod < m_lods.size());
+        return std::span(m_submeshes).subspan(m_lods[lod].submeshOffset, m_lods[lod].submeshCount);
+    }
+
+    auto StaticMesh::select_lod(f32 screen_size) const -> u32
+    {
+        // Max screen sizes decrease with each LOD
+        u32 lod = 0;
+        for (u32 i = 1; i < m_lods.size() && screen_size <= m_lods[i].maxScreenSize; ++i)
+        {
+            lod = i;
+        }
+        return lod;
+    }
+
+    auto StaticMesh::get_bounds_min() const -> const glm::vec3&
+    {
+        return m_boundsMin;
+    }
+
+    auto StaticMesh::get_bounds_max() const -> const glm::vec3&
+    {
+        return m_boundsMax;
+    }
+
     auto StaticMesh::get_index_count() const -> u32
     {
         return m_indexCount;
     };
 
+    auto StaticMesh::get_index_type() const -> rhi::IndexType
+    {
+        return m_indexType;
+    }
+
+    auto StaticMesh::get_vertex_format() const -> StaticVertexFormat
+    {
+        return m_vertexFormat;
+    }
+
     auto StaticMesh::get_index_buffer() const -> rhi::HandleBuffer
     {
         return m_indexBuffer;
@@ -85,4 +252,37 @@ namespace mill
         return m_vertexBuffer;
     }
 
+    auto StaticMesh::get_position_buffer() const -> rhi::HandleBuffer
+    {
+        return m_positionBuffer;
+    }
+
+    bool StaticMesh::has_position_stream() const
+    {
+        return m_positionBuffer != 0;
+    }
+
+    auto StaticMesh::get_cpu_size() const -> u64
+    {
+        return m_vertices.capacity() * sizeof(StaticVertex) + m_indices.capacity() * sizeof(u32) +
+               m_submeshes.capacity() * sizeof(Submesh) + m_lods.capacity() * sizeof(Lod);
+    }
+
+    auto StaticMesh::select_index_type(std::span<const Submesh> submeshes) -> rhi::IndexType
+    {
+        for (const auto& submesh : submeshes)
+        {
+            if (submesh.vertexCount > g_StaticMeshMaxU16VertexCount)
+            {
+                return rhi::IndexType::eU32;
+            }
+        }
+        return rhi::IndexType::eU16;
+    }
+
+    auto StaticMesh::get_gpu_size() const -> u64
+    {
+        return m_indexBufferSize + m_vertexBufferSize + m_positionBufferSize;
+    }
+
 }
\ No newline at end of file
@@ -1,101 +1,150 @@
 #include "mill/io/binary_reader.hpp"
 
+#include <cstring>
+#include <algorithm>
+
 namespace mill
 {
     constexpr auto open_flags = std::ios::binary;
 
-    BinaryReader::BinaryReader(const std::string& filename) : m_filename(filename), m_stream(m_filename, open_flags) {}
+    BinaryReader::BinaryReader(const std::string& filename, size_t block_size)
+        : m_filename(filename), m_stream(m_filename, open_flags), m_buffer(block_size)
+    {
+    }
 
-    BinaryReader::BinaryReader(const std::filesystem::path& filename) : m_filename(filename), m_stream(m_filename, open_flags) {}
+    BinaryReader::BinaryReader(const std::filesystem::path& filename, size_t block_size)
+        : m_filename(filename), m_stream(m_filename, open_flags), m_buffer(block_size)
+    {
+    }
 
     BinaryReader::~BinaryReader()
     {
         m_stream.close();
     }
 
+    template <typename T>
+    auto BinaryReader::read_value() -> T
+    {
+        T value = {};
+        read_raw(&value, sizeof(value));
+        return value;
+    }
+
     void BinaryReader::skip_bytes(size_t num_bytes)
     {
-        m_stream.ignore(num_bytes);
+        const auto buffered_size = m_bufferSize - m_bufferPos;
+        if (num_bytes <= buffered_size)
+        {
+            m_bufferPos += num_bytes;
+            return;
+        }
+
+        m_bufferPos = 0;
+        m_bufferSize = 0;
+        m_stream.ignore(static_cast<std::streamsize>(num_bytes - buffered_size));
     }
 
     auto BinaryReader::read_i8() -> int8_t
     {
-        int8_t value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<int8_t>();
     }
 
     auto BinaryReader::read_i16() -> int16_t
     {
-        int16_t value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<int16_t>();
     }
 
     auto BinaryReader::read_i32() -> int32_t
     {
-        int32_t value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<int32_t>();
     }
 
     auto BinaryReader::read_i64() -> int64_t
     {
-        int64_t value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<int64_t>();
     }
 
     auto BinaryReader::read_u8() -> uint8_t
     {
-        uint8_t value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<uint8_t>();
     }
 
     auto BinaryReader::read_u16() -> uint16_t
     {
-        uint16_t value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<uint16_t>();
     }
 
     auto BinaryReader::read_u32() -> uint32_t
     {
-        uint32_t value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<uint32_t>();
     }
 
     auto BinaryReader::read_u64() -> uint64_t
     {
-        uint64_t value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<uint64_t>();
     }
 
     auto BinaryReader::read_f32() -> float
     {
-        float value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<float>();
     }
 
     auto BinaryReader::read_f64() -> double
     {
-        double value = {};
-        m_stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-        return value;
+        return read_value<double>();
     }
 
     auto BinaryReader::read_str() -> std::string
     {
-        size_t length;
-        m_stream.read(reinterpret_cast<char*>(&length), sizeof(length));
+        const auto length = read_value<size_t>();
         std::string buffer;
         buffer.resize(length);
-        m_stream.read(&buffer[0], length);
+        read_raw(buffer.data(), length);
         return buffer;
     }
 
+    void BinaryReader::read_bytes(std::span<std::byte> bytes)
+    {
+        read_raw(bytes.data(), bytes.size());
+    }
+
+    void BinaryReader::read_raw(void* data, size_t size)
+    {
+        auto* out = static_cast<char*>(data);
+        while (size > 0)
+        {
+            if (m_bufferPos == m_bufferSize)
+            {
+                // Large reads bypass the buffer
+                if (size >= m_buffer.size())
+                {
+                    m_stream.read(out, static_cast<std::streamsize>(size));
+                    const auto read_size = static_cast<size_t>(m_stream.gcount());
+                    std::memset(out + read_size, 0, size - read_size);
+                    return;
+                }
+
+                if (!fill_buffer())
+                {
+                    std::memset(out, 0, size);
+                    return;
+                }
+            }
+
+            const auto copy_size = std::min(size, m_bufferSize - m_bufferPos);
+            std::memcpy(out, m_buffer.data() + m_bufferPos, copy_size);
+            m_bufferPos += copy_size;
+            out += copy_size;
+            size -= copy_size;
+        }
+    }
+
+    bool BinaryReader::fill_buffer()
+    {
+        m_stream.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_bufferPos = 0;
+        m_bufferSize = static_cast<size_t>(m_stream.gcount());
+        return m_bufferSize != 0;
+    }
+
 }
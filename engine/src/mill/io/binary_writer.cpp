@@ -1,81 +1,127 @@
 #include "mill/io/binary_writer.hpp"
 
-#include <cassert>
+#include <cstring>
 
 namespace mill
 {
     constexpr auto open_flags = std::ios::binary | std::ios::trunc;
 
-    BinaryWriter::BinaryWriter(const std::string& filename) : m_filename(filename), m_stream(m_filename, open_flags) {}
+    BinaryWriter::BinaryWriter(const std::string& filename, size_t block_size)
+        : m_filename(filename), m_stream(m_filename, open_flags), m_buffer(block_size)
+    {
+    }
 
-    BinaryWriter::BinaryWriter(const std::filesystem::path& filename) : m_filename(filename), m_stream(m_filename, open_flags) {}
+    BinaryWriter::BinaryWriter(const std::filesystem::path& filename, size_t block_size)
+        : m_filename(filename), m_stream(m_filename, open_flags), m_buffer(block_size)
+    {
+    }
 
     BinaryWriter::~BinaryWriter()
     {
+        flush();
         m_stream.close();
     }
 
+    template <typename T>
+    void BinaryWriter::write_value(T value)
+    {
+        write_raw(&value, sizeof(value));
+    }
+
     void BinaryWriter::clear()
     {
+        m_bufferSize = 0;
         m_stream.close();
         m_stream = std::ofstream(m_filename, open_flags);
     }
 
+    void BinaryWriter::flush()
+    {
+        if (m_bufferSize != 0)
+        {
+            m_stream.write(m_buffer.data(), static_cast<std::streamsize>(m_bufferSize));
+            m_bufferSize = 0;
+        }
+    }
+
     void BinaryWriter::write_i8(int8_t value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_i16(int16_t value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_i32(int32_t value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_i64(int64_t value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_u8(uint8_t value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_u16(uint16_t value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_u32(uint32_t value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_u64(uint64_t value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_f32(float value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write_f64(double value)
     {
-        m_stream.write(reinterpret_cast<char*>(&value), sizeof(value));
+        write_value(value);
     }
 
     void BinaryWriter::write(const std::string& str)
     {
         size_t length = str.length();
-        m_stream.write(reinterpret_cast<char*>(&length), sizeof(length));
-        m_stream.write(&str[0], length);
+        write_value(length);
+        write_raw(str.data(), length);
+    }
+
+    void BinaryWriter::write_bytes(std::span<const std::byte> bytes)
+    {
+        write_raw(bytes.data(), bytes.size());
+    }
+
+    void BinaryWriter::write_raw(const void* data, size_t size)
+    {
+        if (m_bufferSize + size > m_buffer.size())
+        {
+            flush();
+        }
+
+        // Large writes bypass the buffer
+        if (size >= m_buffer.size())
+        {
+            m_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            return;
+        }
+
+        std::memcpy(m_buffer.data() + m_bufferSize, data, size);
+        m_bufferSize += size;
     }
 
-}
\ No newline at end of file
+}
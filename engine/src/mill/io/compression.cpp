@@ -0,0 +1,115 @@
+#include "mill/io/compression.hpp"
+
+#include "mill/core/debug.hpp"
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+#include <limits>
+#include <algorithm>
+
+namespace mill
+{
+    constexpr int g_LZ4CompressionLevel = LZ4HC_CLEVEL_MAX;
+    constexpr int g_ZstdCompressionLevel = 19;
+
+    auto get_codec_name(CompressionCodec codec) -> const char*
+    {
+        switch (codec)
+        {
+            case CompressionCodec::eNone: return "None";
+            case CompressionCodec::eLZ4: return "LZ4";
+            case CompressionCodec::eZstd: return "Zstd";
+        }
+        return "Unknown";
+    }
+
+    auto compress(CompressionCodec codec, std::span<const std::byte> data) -> std::vector<std::byte>
+    {
+        std::vector<std::byte> compressed{};
+        switch (codec)
+        {
+            case CompressionCodec::eNone:
+            {
+                compressed.assign(data.begin(), data.end());
+                break;
+            }
+            case CompressionCodec::eLZ4:
+            {
+                if (data.size() > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+                {
+                    LOG_ERROR("Compression - {} bytes is too large to compress with LZ4.", data.size());
+                    return {};
+                }
+
+                compressed.resize(LZ4_compressBound(static_cast<int>(data.size())));
+                const auto compressed_size = LZ4_compress_HC(reinterpret_cast<const char*>(data.data()),
+                                                             reinterpret_cast<char*>(compressed.data()),
+                                                             static_cast<int>(data.size()),
+                                                             static_cast<int>(compressed.size()),
+                                                             g_LZ4CompressionLevel);
+                if (compressed_size <= 0)
+                {
+                    LOG_ERROR("Compression - LZ4 failed to compress {} bytes.", data.size());
+                    return {};
+                }
+                compressed.resize(compressed_size);
+                break;
+            }
+            case CompressionCodec::eZstd:
+            {
+                compressed.resize(ZSTD_compressBound(data.size()));
+                const auto compressed_size =
+                    ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), g_ZstdCompressionLevel);
+                if (ZSTD_isError(compressed_size))
+                {
+                    LOG_ERROR("Compression - Zstd failed to compress {} bytes: {}", data.size(), ZSTD_getErrorName(compressed_size));
+                    return {};
+                }
+                compressed.resize(compressed_size);
+                break;
+            }
+        }
+
+        return compressed;
+    }
+
+    bool decompress(CompressionCodec codec, std::span<const std::byte> data, std::span<std::byte> out)
+    {
+        switch (codec)
+        {
+            case CompressionCodec::eNone:
+            {
+                if (data.size() != out.size())
+                {
+                    return false;
+                }
+                std::copy(data.begin(), data.end(), out.begin());
+                return true;
+            }
+            case CompressionCodec::eLZ4:
+            {
+                if (data.size() > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+                    out.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+                {
+                    return false;
+                }
+
+                const auto decompressed_size = LZ4_decompress_safe(reinterpret_cast<const char*>(data.data()),
+                                                                   reinterpret_cast<char*>(out.data()),
+                                                                   static_cast<int>(data.size()),
+                                                                   static_cast<int>(out.size()));
+                return decompressed_size >= 0 && static_cast<size_t>(decompressed_size) == out.size();
+            }
+            case CompressionCodec::eZstd:
+            {
+                const auto decompressed_size = ZSTD_decompress(out.data(), out.size(), data.data(), data.size());
+                return !ZSTD_isError(decompressed_size) && decompressed_size == out.size();
+            }
+        }
+
+        return false;
+    }
+
+}
@@ -63,6 +63,11 @@ namespace mill
         m_dataSize += str.size();
     }
 
+    void DummyWriter::write_bytes(std::span<const std::byte> bytes)
+    {
+        m_dataSize += bytes.size();
+    }
+
     auto DummyWriter::get_data_size() const -> size_t
     {
         return m_dataSize;
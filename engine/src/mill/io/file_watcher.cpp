@@ -0,0 +1,182 @@
+#include "mill/io/file_watcher.hpp"
+
+#include "mill/core/debug.hpp"
+
+#include <set>
+
+#if MILL_LINUX
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace mill
+{
+#if MILL_LINUX
+
+    FileWatcher::FileWatcher(const fs::path& directory) : m_directory(directory)
+    {
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd < 0)
+        {
+            LOG_ERROR("FileWatcher - Failed to initialise inotify for <{}>.", m_directory.string());
+            return;
+        }
+
+        add_watch(m_directory);
+
+        std::error_code error{};
+        for (const auto& dir_entry : fs::recursive_directory_iterator(m_directory, error))
+        {
+            if (dir_entry.is_directory())
+            {
+                add_watch(dir_entry.path());
+            }
+        }
+
+        m_isWatching = !m_watchedDirectories.empty();
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        if (m_inotifyFd >= 0)
+        {
+            close(m_inotifyFd);
+        }
+    }
+
+    auto FileWatcher::poll() -> std::vector<fs::path>
+    {
+        if (!m_isWatching)
+        {
+            return {};
+        }
+
+        std::set<fs::path> changed_files{};
+
+        alignas(inotify_event) char buffer[4096];
+        while (true)
+        {
+            const auto read_size = read(m_inotifyFd, buffer, sizeof(buffer));
+            if (read_size <= 0)
+            {
+                break;
+            }
+
+            for (auto* ptr = buffer; ptr < buffer + read_size;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                const auto dir_it = m_watchedDirectories.find(event->wd);
+                if (dir_it == m_watchedDirectories.end() || event->len == 0)
+                {
+                    continue;
+                }
+
+                const auto path = dir_it->second / event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    add_watch(path);
+                }
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    changed_files.insert(path);
+                }
+            }
+        }
+
+        return { changed_files.begin(), changed_files.end() };
+    }
+
+    void FileWatcher::add_watch(const fs::path& directory)
+    {
+        const auto watch_descriptor = inotify_add_watch(m_inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (watch_descriptor < 0)
+        {
+            LOG_WARN("FileWatcher - Failed to watch directory <{}>.", directory.string());
+            return;
+        }
+
+        m_watchedDirectories[watch_descriptor] = directory;
+    }
+
+#else
+
+    constexpr auto g_FileWatcherScanInterval = std::chrono::milliseconds(500);
+
+    FileWatcher::FileWatcher(const fs::path& directory) : m_directory(directory)
+    {
+        m_isWatching = fs::is_directory(m_directory);
+        if (!m_isWatching)
+        {
+            LOG_ERROR("FileWatcher - <{}> is not a directory.", m_directory.string());
+            return;
+        }
+
+        scan(nullptr);
+    }
+
+    FileWatcher::~FileWatcher() = default;
+
+    auto FileWatcher::poll() -> std::vector<fs::path>
+    {
+        if (!m_isWatching || std::chrono::steady_clock::now() - m_lastScanTime < g_FileWatcherScanInterval)
+        {
+            return {};
+        }
+
+        std::vector<fs::path> changed_files{};
+        scan(&changed_files);
+        return changed_files;
+    }
+
+    void FileWatcher::scan(std::vector<fs::path>* changed_files)
+    {
+        m_lastScanTime = std::chrono::steady_clock::now();
+
+        // Files being written to may disappear or be locked mid-scan, so errors are ignored and picked up on a later scan
+        std::error_code error{};
+        for (const auto& dir_entry : fs::recursive_directory_iterator(m_directory, error))
+        {
+            if (!dir_entry.is_regular_file(error))
+            {
+                continue;
+            }
+
+            const auto write_time = dir_entry.last_write_time(error);
+            if (error)
+            {
+                continue;
+            }
+
+            auto [it, inserted] = m_fileTimes.try_emplace(dir_entry.path(), write_time);
+            if (!inserted && it->second != write_time)
+            {
+                it->second = write_time;
+                if (changed_files != nullptr)
+                {
+                    changed_files->push_back(dir_entry.path());
+                }
+            }
+            else if (inserted && changed_files != nullptr)
+            {
+                changed_files->push_back(dir_entry.path());
+            }
+        }
+    }
+
+#endif
+
+    bool FileWatcher::is_watching() const
+    {
+        return m_isWatching;
+    }
+
+    auto FileWatcher::get_directory() const -> const fs::path&
+    {
+        return m_directory;
+    }
+
+}
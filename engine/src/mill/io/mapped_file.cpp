@@ -0,0 +1,157 @@
+#include "mill/io/mapped_file.hpp"
+
+#include "mill/core/debug.hpp"
+
+#if MILL_WINDOWS
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#elif MILL_LINUX
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace mill
+{
+#if MILL_WINDOWS
+
+    MappedFile::MappedFile(const std::filesystem::path& filename) : m_filename(filename)
+    {
+        // Share delete access, so the file can be replaced by renaming a new one over it while mapped
+        auto file_handle = CreateFileW(m_filename.c_str(),
+                                       GENERIC_READ,
+                                       FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                       nullptr,
+                                       OPEN_EXISTING,
+                                       FILE_FLAG_SEQUENTIAL_SCAN,
+                                       nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE)
+        {
+            LOG_ERROR("MappedFile - Failed to open file <{}>.", m_filename.string());
+            return;
+        }
+        m_fileHandle = file_handle;
+
+        LARGE_INTEGER file_size{};
+        GetFileSizeEx(file_handle, &file_size);
+        m_size = static_cast<u64>(file_size.QuadPart);
+        m_isOpen = true;
+
+        // Empty files cannot be mapped
+        if (m_size == 0)
+        {
+            return;
+        }
+
+        m_mappingHandle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mappingHandle == nullptr)
+        {
+            LOG_ERROR("MappedFile - Failed to create file mapping <{}>.", m_filename.string());
+            m_isOpen = false;
+            return;
+        }
+
+        m_data = static_cast<const std::byte*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (m_data == nullptr)
+        {
+            LOG_ERROR("MappedFile - Failed to map view of file <{}>.", m_filename.string());
+            m_isOpen = false;
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_data != nullptr)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mappingHandle != nullptr)
+        {
+            CloseHandle(m_mappingHandle);
+        }
+        if (m_fileHandle != nullptr)
+        {
+            CloseHandle(m_fileHandle);
+        }
+    }
+
+#elif MILL_LINUX
+
+    MappedFile::MappedFile(const std::filesystem::path& filename) : m_filename(filename)
+    {
+        const int fd = open(m_filename.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            LOG_ERROR("MappedFile - Failed to open file <{}>.", m_filename.string());
+            return;
+        }
+
+        struct stat file_stat
+        {
+        };
+        fstat(fd, &file_stat);
+        m_size = static_cast<u64>(file_stat.st_size);
+        m_isOpen = true;
+
+        // Empty files cannot be mapped
+        if (m_size != 0)
+        {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                LOG_ERROR("MappedFile - Failed to map file <{}>.", m_filename.string());
+                m_isOpen = false;
+            }
+            else
+            {
+                m_data = static_cast<const std::byte*>(data);
+            }
+        }
+
+        // The mapping keeps its own reference to the file
+        close(fd);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_data != nullptr)
+        {
+            munmap(const_cast<std::byte*>(m_data), m_size);
+        }
+    }
+
+#endif
+
+    bool MappedFile::is_open() const
+    {
+        return m_isOpen;
+    }
+
+    auto MappedFile::get_filename() const -> const std::filesystem::path&
+    {
+        return m_filename;
+    }
+
+    auto MappedFile::get_size() const -> u64
+    {
+        return m_size;
+    }
+
+    auto MappedFile::get_data() const -> std::span<const std::byte>
+    {
+        return { m_data, m_data != nullptr ? m_size : 0 };
+    }
+
+    auto MappedFile::get_slice(u64 offset, u64 size) const -> std::span<const std::byte>
+    {
+        if (m_data == nullptr || offset > m_size || size > m_size - offset)
+        {
+            return {};
+        }
+
+        return { m_data + offset, size };
+    }
+
+}
@@ -0,0 +1,125 @@
+#include "mill/io/memory_reader.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+namespace mill
+{
+    MemoryReader::MemoryReader(std::span<const std::byte> data) : m_data(data) {}
+
+    template <typename T>
+    auto MemoryReader::read_value() -> T
+    {
+        T value = {};
+        const auto bytes = view_bytes(sizeof(T));
+        if (!bytes.empty())
+        {
+            std::memcpy(&value, bytes.data(), sizeof(T));
+        }
+        return value;
+    }
+
+    void MemoryReader::skip_bytes(size_t num_bytes)
+    {
+        view_bytes(num_bytes);
+    }
+
+    auto MemoryReader::read_i8() -> int8_t
+    {
+        return read_value<int8_t>();
+    }
+
+    auto MemoryReader::read_i16() -> int16_t
+    {
+        return read_value<int16_t>();
+    }
+
+    auto MemoryReader::read_i32() -> int32_t
+    {
+        return read_value<int32_t>();
+    }
+
+    auto MemoryReader::read_i64() -> int64_t
+    {
+        return read_value<int64_t>();
+    }
+
+    auto MemoryReader::read_u8() -> uint8_t
+    {
+        return read_value<uint8_t>();
+    }
+
+    auto MemoryReader::read_u16() -> uint16_t
+    {
+        return read_value<uint16_t>();
+    }
+
+    auto MemoryReader::read_u32() -> uint32_t
+    {
+        return read_value<uint32_t>();
+    }
+
+    auto MemoryReader::read_u64() -> uint64_t
+    {
+        return read_value<uint64_t>();
+    }
+
+    auto MemoryReader::read_f32() -> float
+    {
+        return read_value<float>();
+    }
+
+    auto MemoryReader::read_f64() -> double
+    {
+        return read_value<double>();
+    }
+
+    auto MemoryReader::read_str() -> std::string
+    {
+        const auto length = read_value<size_t>();
+        const auto bytes = view_bytes(length);
+        return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+    }
+
+    void MemoryReader::read_bytes(std::span<std::byte> bytes)
+    {
+        const auto source = view_bytes(bytes.size());
+        if (source.empty())
+        {
+            std::fill(bytes.begin(), bytes.end(), std::byte{ 0 });
+            return;
+        }
+
+        std::memcpy(bytes.data(), source.data(), source.size());
+    }
+
+    auto MemoryReader::view_bytes(size_t num_bytes) -> std::span<const std::byte>
+    {
+        if (num_bytes > get_remaining_size())
+        {
+            m_position = m_data.size();
+            m_hasOverrun = true;
+            return {};
+        }
+
+        const auto bytes = m_data.subspan(m_position, num_bytes);
+        m_position += num_bytes;
+        return bytes;
+    }
+
+    auto MemoryReader::get_position() const -> size_t
+    {
+        return m_position;
+    }
+
+    auto MemoryReader::get_remaining_size() const -> size_t
+    {
+        return m_data.size() - m_position;
+    }
+
+    bool MemoryReader::has_overrun() const
+    {
+        return m_hasOverrun;
+    }
+
+}
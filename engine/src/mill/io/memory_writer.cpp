@@ -0,0 +1,100 @@
+#include "mill/io/memory_writer.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace mill
+{
+    MemoryWriter::MemoryWriter(size_t reserve_size)
+    {
+        m_data.reserve(reserve_size);
+    }
+
+    template <typename T>
+    void MemoryWriter::write_value(T value)
+    {
+        write_bytes(std::as_bytes(std::span(&value, 1)));
+    }
+
+    void MemoryWriter::clear()
+    {
+        m_data.clear();
+    }
+
+    void MemoryWriter::write_i8(int8_t value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_i16(int16_t value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_i32(int32_t value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_i64(int64_t value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_u8(uint8_t value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_u16(uint16_t value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_u32(uint32_t value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_u64(uint64_t value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_f32(float value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write_f64(double value)
+    {
+        write_value(value);
+    }
+
+    void MemoryWriter::write(const std::string& str)
+    {
+        write_value(str.length());
+        write_bytes(std::as_bytes(std::span(str)));
+    }
+
+    void MemoryWriter::write_bytes(std::span<const std::byte> bytes)
+    {
+        m_data.insert(m_data.end(), bytes.begin(), bytes.end());
+    }
+
+    auto MemoryWriter::get_data() const -> std::span<const std::byte>
+    {
+        return m_data;
+    }
+
+    auto MemoryWriter::get_data_size() const -> size_t
+    {
+        return m_data.size();
+    }
+
+    auto MemoryWriter::release_data() -> std::vector<std::byte>
+    {
+        return std::exchange(m_data, {});
+    }
+
+}
@@ -0,0 +1,172 @@
+#include "mill/io/trace_writer.hpp"
+
+#include "mill/core/debug.hpp"
+
+#include <format>
+#include <algorithm>
+#include <string>
+
+namespace mill
+{
+    namespace
+    {
+        auto escape_json(std::string_view str) -> std::string
+        {
+            std::string escaped{};
+            escaped.reserve(str.size());
+            for (const char c : str)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    escaped.push_back('\\');
+                    escaped.push_back(c);
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    // Control characters (eg. a newline in an asset name) are not allowed unescaped in JSON strings
+                    escaped += std::format("\\u{:04x}", static_cast<u32>(c));
+                }
+                else
+                {
+                    escaped.push_back(c);
+                }
+            }
+            return escaped;
+        }
+    }
+
+    TraceWriter::~TraceWriter()
+    {
+        close();
+    }
+
+    bool TraceWriter::open(const std::filesystem::path& filename)
+    {
+        close();
+
+        std::lock_guard lock(m_mutex);
+        m_file.open(filename, std::ios::out | std::ios::trunc);
+        if (!m_file.is_open())
+        {
+            LOG_ERROR("TraceWriter - Failed to open trace file <{}>!", filename.string());
+            return false;
+        }
+
+        m_file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        m_hasEvents = false;
+        m_startTime = Clock::now();
+        m_isOpen = true;
+
+        LOG_INFO("TraceWriter - Capturing trace to <{}>.", filename.string());
+        return true;
+    }
+
+    void TraceWriter::close()
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_isOpen)
+        {
+            return;
+        }
+
+        m_file << "\n]}\n";
+        m_file.close();
+        m_isOpen = false;
+    }
+
+    void TraceWriter::add_complete_event(std::string_view name,
+                                         std::string_view category,
+                                         u32 thread_id,
+                                         Clock::time_point start,
+                                         Clock::time_point end,
+                                         std::string_view args_json)
+    {
+        if (!is_open())
+        {
+            return;
+        }
+
+        const auto start_us = get_timestamp_us(start);
+        const auto duration_us = std::max<i64>(get_timestamp_us(end) - start_us, 0);
+        write_event(std::format(R"({{"name":"{}","cat":"{}","ph":"X","pid":1,"tid":{},"ts":{},"dur":{},"args":{}}})",
+                                escape_json(name),
+                                escape_json(category),
+                                thread_id,
+                                start_us,
+                                duration_us,
+                                args_json.empty() ? "{}" : args_json));
+    }
+
+    void TraceWriter::add_async_event(std::string_view name,
+                                      std::string_view category,
+                                      u64 id,
+                                      Clock::time_point start,
+                                      Clock::time_point end,
+                                      std::string_view args_json)
+    {
+        if (!is_open())
+        {
+            return;
+        }
+
+        const auto escaped_name = escape_json(name);
+        const auto escaped_category = escape_json(category);
+        write_event(std::format(R"({{"name":"{}","cat":"{}","ph":"b","pid":1,"id":{},"ts":{},"args":{}}})",
+                                escaped_name,
+                                escaped_category,
+                                id,
+                                get_timestamp_us(start),
+                                args_json.empty() ? "{}" : args_json));
+        write_event(std::format(R"({{"name":"{}","cat":"{}","ph":"e","pid":1,"id":{},"ts":{}}})",
+                                escaped_name,
+                                escaped_category,
+                                id,
+                                get_timestamp_us(end)));
+    }
+
+    void TraceWriter::set_thread_name(u32 thread_id, std::string_view name)
+    {
+        if (!is_open())
+        {
+            return;
+        }
+
+        write_event(std::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})", thread_id, escape_json(name)));
+    }
+
+    bool TraceWriter::is_open() const
+    {
+        return m_isOpen;
+    }
+
+    void TraceWriter::write_event(const std::string& event_json)
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_isOpen)
+        {
+            return;
+        }
+
+        if (m_hasEvents)
+        {
+            m_file << ",\n";
+        }
+        m_file << event_json;
+        m_hasEvents = true;
+    }
+
+    auto TraceWriter::get_timestamp_us(Clock::time_point time) const -> i64
+    {
+        Clock::time_point start_time{};
+        {
+            // Written by open(), which may start a new capture while other threads are adding events
+            std::lock_guard lock(m_mutex);
+            start_time = m_startTime;
+        }
+
+        // Events may have started before the capture (eg. a load that was already queued)
+        const auto since_start = std::chrono::duration_cast<std::chrono::microseconds>(time - start_time).count();
+        return std::max<i64>(since_start, 0);
+    }
+
+}
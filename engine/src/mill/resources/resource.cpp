@@ -0,0 +1,13 @@
+#include "mill/resources/resource.hpp"
+
+#include <atomic>
+
+namespace mill
+{
+    auto allocate_resource_type_index() -> u32
+    {
+        static std::atomic<u32> s_NextIndex{ 0 };
+        return s_NextIndex.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}
@@ -1,25 +1,164 @@
 #include "mill/resources/resource_cache.hpp"
 
+#include "mill/core/debug.hpp"
+
 namespace mill
 {
-    void ResourceCache::add(ResourceId id, Owned<Resource> resource)
+    auto ResourceCache::add(ResourceId id, Owned<Resource> resource) -> Resource*
     {
-        m_cache[id] = std::move(resource);
+        ASSERT(resource != nullptr);
+
+        erase(id);
+
+        auto& entry = m_cache[id];
+        entry.cpuSize = resource->get_cpu_size();
+        entry.gpuSize = resource->get_gpu_size();
+        entry.storageIndex = store(std::move(resource));
+        entry.resource = get_stored(entry.storageIndex);
+        entry.lruIt = m_lruList.insert(m_lruList.begin(), id);
+
+        ++m_stats.residentCount;
+        m_stats.residentCpuBytes += entry.cpuSize;
+        m_stats.residentGpuBytes += entry.gpuSize;
+        return entry.resource;
     }
 
     auto ResourceCache::get(ResourceId id) -> Resource*
     {
-        return m_cache.at(id).get();
+        const auto it = m_cache.find(id);
+        if (it == m_cache.end())
+        {
+            ++m_stats.misses;
+            return nullptr;
+        }
+
+        ++m_stats.hits;
+        auto& entry = it->second;
+        m_lruList.splice(m_lruList.begin(), m_lruList, entry.lruIt);
+        return entry.resource;
+    }
+
+    auto ResourceCache::find(ResourceId id) const -> Resource*
+    {
+        const auto it = m_cache.find(id);
+        return it != m_cache.end() ? it->second.resource : nullptr;
+    }
+
+    void ResourceCache::touch(ResourceId id)
+    {
+        const auto it = m_cache.find(id);
+        if (it != m_cache.end())
+        {
+            m_lruList.splice(m_lruList.begin(), m_lruList, it->second.lruIt);
+        }
     }
 
-    void mill::ResourceCache::erase(ResourceId id)
+    void ResourceCache::erase(ResourceId id)
     {
-        m_cache.erase(id);
+        remove(id);
     }
 
-    bool mill::ResourceCache::contains(ResourceId id)
+    bool ResourceCache::contains(ResourceId id) const
     {
         return m_cache.contains(id);
     }
 
+    auto ResourceCache::replace(ResourceId id, Owned<Resource> resource) -> Owned<Resource>
+    {
+        ASSERT(resource != nullptr);
+
+        auto& entry = m_cache.at(id);
+        m_stats.residentCpuBytes -= entry.cpuSize;
+        m_stats.residentGpuBytes -= entry.gpuSize;
+
+        entry.cpuSize = resource->get_cpu_size();
+        entry.gpuSize = resource->get_gpu_size();
+        m_stats.residentCpuBytes += entry.cpuSize;
+        m_stats.residentGpuBytes += entry.gpuSize;
+
+        return exchange_stored(entry.storageIndex, std::move(resource));
+    }
+
+    auto ResourceCache::evict(ResourceId id) -> Owned<Resource>
+    {
+        auto resource = remove(id);
+        if (resource != nullptr)
+        {
+            ++m_stats.evictions;
+        }
+        return resource;
+    }
+
+    auto ResourceCache::remove(ResourceId id) -> Owned<Resource>
+    {
+        const auto it = m_cache.find(id);
+        if (it == m_cache.end())
+        {
+            return nullptr;
+        }
+
+        auto& entry = it->second;
+        --m_stats.residentCount;
+        m_stats.residentCpuBytes -= entry.cpuSize;
+        m_stats.residentGpuBytes -= entry.gpuSize;
+        m_lruList.erase(entry.lruIt);
+
+        auto resource = extract_stored(entry.storageIndex);
+        m_cache.erase(it);
+        return resource;
+    }
+
+    auto ResourceCache::get_eviction_candidates(const CanEvictFunc& can_evict) const -> std::vector<ResourceId>
+    {
+        std::vector<ResourceId> candidates{};
+
+        auto cpu_bytes = m_stats.residentCpuBytes;
+        auto gpu_bytes = m_stats.residentGpuBytes;
+        for (auto it = m_lruList.rbegin(); it != m_lruList.rend(); ++it)
+        {
+            if (cpu_bytes <= m_budget.cpuBytes && gpu_bytes <= m_budget.gpuBytes)
+            {
+                break;
+            }
+
+            const auto id = *it;
+            if (!can_evict(id))
+            {
+                continue;
+            }
+
+            const auto& entry = m_cache.at(id);
+            cpu_bytes -= entry.cpuSize;
+            gpu_bytes -= entry.gpuSize;
+            candidates.push_back(id);
+        }
+
+        return candidates;
+    }
+
+    void ResourceCache::set_budget(const ResourceCacheBudget& budget)
+    {
+        m_budget = budget;
+    }
+
+    auto ResourceCache::get_budget() const -> const ResourceCacheBudget&
+    {
+        return m_budget;
+    }
+
+    auto ResourceCache::get_stats() const -> ResourceCacheStats
+    {
+        return m_stats;
+    }
+
+    bool ResourceCache::has_budget() const
+    {
+        return m_budget.cpuBytes != u64_max || m_budget.gpuBytes != u64_max;
+    }
+
+    bool ResourceCache::is_over_budget() const
+    {
+        return m_stats.residentCpuBytes > m_budget.cpuBytes || m_stats.residentGpuBytes > m_budget.gpuBytes;
+    }
+
 }
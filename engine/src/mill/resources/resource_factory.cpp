@@ -1,13 +1,37 @@
 #include "mill/resources/resource_factory.hpp"
 
-#include "mill/io/binary_reader.hpp"
+#include "mill/io/memory_reader.hpp"
 #include "mill/graphics/static_mesh.hpp"
 
+#include <bit>
+#include <cstring>
+
 namespace mill
 {
-    auto StaticMeshFactory::load(const ResourceMetadata& metadata) -> Owned<Resource>
+    // Vertex, index & submesh blocks are used as-is, so the in-memory layout must match the on-disk layout.
+    static_assert(std::endian::native == std::endian::little);
+    static_assert(sizeof(StaticVertex) == sizeof(f32) * 8);
+    static_assert(sizeof(QuantizedStaticVertex) == sizeof(u16) * 6 + sizeof(u8) * 4);
+    static_assert(sizeof(StaticMesh::Lod) == sizeof(u32) * 2 + sizeof(f32));
+    static_assert(sizeof(StaticVertexAttributes) == sizeof(f32) * 5);
+    static_assert(sizeof(QuantizedStaticVertexAttributes) == sizeof(u16) * 2 + sizeof(u8) * 4);
+    static_assert(sizeof(StaticMesh::Submesh) == sizeof(u32) * 5 + sizeof(f32) * 6);
+
+    // Size of a submesh before format version 3, which has no bounds
+    constexpr sizet g_LegacySubmeshSize = sizeof(u32) * 5;
+
+    namespace
     {
-        BinaryReader reader(metadata.binaryFile);
+        void skip_to_block_alignment(MemoryReader& reader)
+        {
+            const auto position = reader.get_position();
+            reader.skip_bytes(align_up(position, g_StaticMeshBlockAlignment) - position);
+        }
+    }
+
+    auto StaticMeshFactory::load(const ResourceMetadata& metadata, std::span<const std::byte> data) -> Owned<Resource>
+    {
+        MemoryReader reader(data);
 
         // File Header
         std::string header(3, ' ');
@@ -23,62 +47,157 @@ namespace mill
 
         // Format Version
         u16 format_version = reader.read_u16();
-        UNUSED(format_version);
+        if (format_version > g_StaticMeshFormatVersion)
+        {
+            LOG_ERROR("ResourceManager - StaticMeshFactory - Resource <{}> has unsupported format version {}!", metadata.id, format_version);
+            return nullptr;
+        }
 
         // Resource Id
         u64 resource_id = reader.read_u64();
         UNUSED(resource_id);
 
-        // Vertices
-        sizet vertex_count = reader.read_u64();
-        std::vector<StaticVertex> vertices{};
-        vertices.reserve(vertex_count);
-        for (sizet i = 0; i < vertex_count; ++i)
+        // Vertices, triangles & sub-meshes are all stored tightly packed, so the vertex and index data is uploaded directly from
+        // the mapping.
+        std::span<const std::byte> vertex_data{};
+        std::span<const std::byte> position_data{};
+        std::span<const std::byte> index_data{};
+        std::span<const std::byte> submesh_data{};
+        std::span<const std::byte> lod_data{};
+        u32 index_size = sizeof(u16);
+        auto vertex_format = StaticVertexFormat::eFloat;
+        sizet submesh_size = g_LegacySubmeshSize;
+        if (format_version == 0)
         {
-            auto& vertex = vertices.emplace_back();
+            sizet vertex_count = reader.read_u64();
+            vertex_data = reader.view_bytes(vertex_count * sizeof(StaticVertex));
+
+            sizet triangle_count = reader.read_u64();
+            index_data = reader.view_bytes(triangle_count * sizeof(u16));
+
+            sizet submesh_count = reader.read_u64();
+            submesh_data = reader.view_bytes(submesh_count * submesh_size);
+        }
+        else
+        {
+            sizet vertex_count = reader.read_u64();
+            sizet triangle_count = reader.read_u64();
+            sizet submesh_count = reader.read_u64();
+            if (format_version >= 2)
+            {
+                index_size = reader.read_u32();
+                if (index_size != sizeof(u16) && index_size != sizeof(u32))
+                {
+                    LOG_ERROR("ResourceManager - StaticMeshFactory - Resource <{}> has unsupported index size {}!", metadata.id, index_size);
+                    return nullptr;
+                }
+            }
+            if (format_version >= 3)
+            {
+                // Validate before narrowing to the u8 enum, so eg. 256 is not truncated into a valid format
+                const u32 vertex_format_value = reader.read_u32();
+                if (vertex_format_value != enum_to_underlying(StaticVertexFormat::eFloat) &&
+                    vertex_format_value != enum_to_underlying(StaticVertexFormat::eQuantized))
+                {
+                    LOG_ERROR("ResourceManager - StaticMeshFactory - Resource <{}> has unsupported vertex format {}!",
+                              metadata.id,
+                              vertex_format_value);
+                    return nullptr;
+                }
+                vertex_format = static_cast<StaticVertexFormat>(vertex_format_value);
+                submesh_size = sizeof(StaticMesh::Submesh);
+            }
+            const bool has_position_stream = format_version >= 4 && reader.read_u32() != 0;
+            const sizet lod_count = format_version >= 5 ? reader.read_u32() : 0;
+
+            const bool is_quantized = vertex_format == StaticVertexFormat::eQuantized;
+            if (has_position_stream)
+            {
+                const auto position_size = is_quantized ? sizeof(QuantizedStaticVertex::position) : sizeof(StaticVertex::position);
+                const auto attributes_size = is_quantized ? sizeof(QuantizedStaticVertexAttributes) : sizeof(StaticVertexAttributes);
+
+                skip_to_block_alignment(reader);
+                position_data = reader.view_bytes(vertex_count * position_size);
+
+                skip_to_block_alignment(reader);
+                vertex_data = reader.view_bytes(vertex_count * attributes_size);
+            }
+            else
+            {
+                skip_to_block_alignment(reader);
+                vertex_data = reader.view_bytes(vertex_count * (is_quantized ? sizeof(QuantizedStaticVertex) : sizeof(StaticVertex)));
+            }
 
-            vertex.position.x = reader.read_f32();
-            vertex.position.y = reader.read_f32();
-            vertex.position.z = reader.read_f32();
+            skip_to_block_alignment(reader);
+            index_data = reader.view_bytes(triangle_count * index_size);
 
-            vertex.texCoord.x = reader.read_f32();
-            vertex.texCoord.y = reader.read_f32();
+            skip_to_block_alignment(reader);
+            submesh_data = reader.view_bytes(submesh_count * submesh_size);
 
-            vertex.color.x = reader.read_f32();
-            vertex.color.y = reader.read_f32();
-            vertex.color.z = reader.read_f32();
+            if (lod_count != 0)
+            {
+                skip_to_block_alignment(reader);
+                lod_data = reader.view_bytes(lod_count * sizeof(StaticMesh::Lod));
+            }
         }
 
-        // Triangles
-        sizet triangle_count = reader.read_u64();
-        std::vector<u16> triangles{};
-        triangles.reserve(triangle_count);
-        for (sizet i = 0; i < triangle_count; ++i)
+        if (reader.has_overrun())
         {
-            triangles.push_back(reader.read_u16());
+            LOG_ERROR("ResourceManager - StaticMeshFactory - Resource <{}> data is truncated!", metadata.id);
+            return nullptr;
         }
 
-        // Sub-meshes
-        sizet submesh_count = reader.read_u64();
-        std::vector<StaticMesh::Submesh> submeshes{};
-        submeshes.reserve(submesh_count);
-        for (sizet i = 0; i < submesh_count; ++i)
+        // Older submeshes are a prefix of the current layout, so are copied one at a time
+        std::vector<StaticMesh::Submesh> submeshes(submesh_data.size() / submesh_size);
+        for (sizet i = 0; i < submeshes.size(); ++i)
         {
-            auto& submesh = submeshes.emplace_back();
+            std::memcpy(&submeshes[i], submesh_data.data() + i * submesh_size, submesh_size);
+        }
 
-            submesh.indexOffset = reader.read_u32();
-            submesh.indexCount = reader.read_u32();
-            submesh.vertexOffset = reader.read_u32();
-            submesh.vertexCount = reader.read_u32();
-            submesh.materialIndex = reader.read_u32();
+        std::vector<StaticMesh::Lod> lods(lod_data.size() / sizeof(StaticMesh::Lod));
+        if (!lods.empty())
+        {
+            std::memcpy(lods.data(), lod_data.data(), lods.size() * sizeof(StaticMesh::Lod));
+        }
+        for (const auto& lod : lods)
+        {
+            if (lod.submeshOffset + lod.submeshCount > submeshes.size())
+            {
+                LOG_ERROR("ResourceManager - StaticMeshFactory - Resource <{}> has a LOD outside of its submeshes!", metadata.id);
+                return nullptr;
+            }
         }
 
         auto static_mesh = CreateOwned<StaticMesh>();
-        static_mesh->set_vertices(vertices);
-        static_mesh->set_triangles(triangles);
+        static_mesh->set_vertex_data(vertex_data, vertex_format, position_data);
+        static_mesh->set_index_data(index_data, index_size == sizeof(u16) ? rhi::IndexType::eU16 : rhi::IndexType::eU32);
         static_mesh->set_submeshes(submeshes);
-        static_mesh->apply();
+        static_mesh->set_lods(lods);
         return std::move(static_mesh);
     }
 
+    void StaticMeshFactory::on_loaded(Resource& resource)
+    {
+        auto& static_mesh = static_cast<StaticMesh&>(resource);
+        static_mesh.apply();
+    }
+
+    bool StaticMeshFactory::is_ready(const Resource& resource)
+    {
+        const auto& static_mesh = static_cast<const StaticMesh&>(resource);
+        return static_mesh.is_uploaded();
+    }
+
+    void StaticMeshFactory::wait_until_ready(const Resource& resource)
+    {
+        const auto& static_mesh = static_cast<const StaticMesh&>(resource);
+        static_mesh.wait_until_uploaded();
+    }
+
+    void StaticMeshFactory::on_unloaded(Resource& resource)
+    {
+        auto& static_mesh = static_cast<StaticMesh&>(resource);
+        static_mesh.release();
+    }
+
 }
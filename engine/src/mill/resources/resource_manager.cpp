@@ -2,60 +2,150 @@
 
 #include "mill/core/debug.hpp"
 
+#include <cmath>
+#include <atomic>
+#include <format>
+#include <utility>
+#include <algorithm>
 #include <filesystem>
 namespace fs = std::filesystem;
 
 #include <yaml-cpp/yaml.h>
 
+#include <unordered_set>
+
 namespace mill
 {
     constexpr auto* g_MetadataFileExt = ".yaml";
+    constexpr sizet g_LatencySampleCount = 256;  // Recent loads per resource type, used for latency percentiles
+    constexpr u32 g_MainThreadTraceId = 0;
+
+    namespace
+    {
+        bool is_same_file(const fs::path& lhs, const fs::path& rhs)
+        {
+            return lhs.lexically_normal() == rhs.lexically_normal();
+        }
+
+        /* Nearest-rank percentile of already sorted values. */
+        auto get_percentile(const std::vector<f64>& sorted_values, f64 percentile) -> f64
+        {
+            ASSERT(!sorted_values.empty());
+            const auto rank = static_cast<sizet>(std::ceil(percentile * static_cast<f64>(sorted_values.size())));
+            return sorted_values[std::clamp<sizet>(rank, 1, sorted_values.size()) - 1];
+        }
+    }
 
     ResourceHandle::ResourceHandle(ResourceManager& manager, ResourceId id) : m_manager(&manager), m_id(id)
     {
         m_metadata = &m_manager->get_metadata(m_id);
-        m_refCount = m_metadata->refCount;
+        m_metadata->refCount.add_ref();
     }
 
     ResourceHandle::ResourceHandle(Resource* resource) : m_resource(resource) {}
 
     ResourceHandle::ResourceHandle(const ResourceHandle& other)
+        : m_manager(other.m_manager), m_id(other.m_id), m_metadata(other.m_metadata), m_resource(other.m_resource), m_slot(other.m_slot)
     {
-        m_manager = other.m_manager;
-        m_id = other.m_id;
-        m_metadata = other.m_metadata;
-        m_refCount = other.m_refCount;
+        if (m_metadata != nullptr)
+        {
+            m_metadata->refCount.add_ref();
+        }
     }
 
     ResourceHandle::ResourceHandle(ResourceHandle&& other) noexcept
+        : m_manager(std::exchange(other.m_manager, nullptr)),
+          m_id(std::exchange(other.m_id, 0)),
+          m_metadata(std::exchange(other.m_metadata, nullptr)),
+          m_resource(std::exchange(other.m_resource, nullptr)),
+          m_slot(std::exchange(other.m_slot, {}))
+    {
+    }
+
+    ResourceHandle::~ResourceHandle()
+    {
+        reset();
+    }
+
+    void ResourceHandle::reset()
+    {
+        if (m_metadata != nullptr && m_metadata->refCount.release())
+        {
+            m_manager->on_last_reference_released(m_id);
+        }
+
+        m_manager = nullptr;
+        m_id = 0;
+        m_metadata = nullptr;
+        m_resource = nullptr;
+        m_slot = {};
+    }
+
+    auto ResourceHandle::get_id() const -> ResourceId
     {
-        std::swap(m_manager, other.m_manager);
-        std::swap(m_id, other.m_id);
-        std::swap(m_metadata, other.m_metadata);
-        std::swap(m_refCount, m_refCount);
+        return m_id;
     }
 
     auto ResourceHandle::operator=(const ResourceHandle& rhs) -> ResourceHandle&
     {
-        m_manager = rhs.m_manager;
-        m_id = rhs.m_id;
-        m_metadata = rhs.m_metadata;
-        m_refCount = rhs.m_refCount;
+        if (this != &rhs)
+        {
+            *this = ResourceHandle(rhs);
+        }
         return *this;
     }
 
     auto ResourceHandle::operator=(ResourceHandle&& rhs) noexcept -> ResourceHandle&
     {
-        std::swap(m_manager, rhs.m_manager);
-        std::swap(m_id, rhs.m_id);
-        std::swap(m_metadata, rhs.m_metadata);
-        std::swap(m_refCount, rhs.m_refCount);
+        if (this != &rhs)
+        {
+            reset();
+            m_manager = std::exchange(rhs.m_manager, nullptr);
+            m_id = std::exchange(rhs.m_id, 0);
+            m_metadata = std::exchange(rhs.m_metadata, nullptr);
+            m_resource = std::exchange(rhs.m_resource, nullptr);
+            m_slot = std::exchange(rhs.m_slot, {});
+        }
         return *this;
     }
 
     ResourceHandle::operator bool() const
     {
-        return m_metadata->isLoaded;
+        if (m_metadata != nullptr)
+        {
+            return m_metadata->isLoaded;
+        }
+        return m_resource != nullptr;
+    }
+
+    auto ResourcePrefetch::get_total_count() const -> u32
+    {
+        return CAST_U32(m_handles.size());
+    }
+
+    auto ResourcePrefetch::get_loaded_count() const -> u32
+    {
+        return m_loadedCount;
+    }
+
+    auto ResourcePrefetch::get_failed_count() const -> u32
+    {
+        return m_failedCount;
+    }
+
+    auto ResourcePrefetch::get_progress() const -> f32
+    {
+        if (m_handles.empty())
+        {
+            return 1.0f;
+        }
+
+        return static_cast<f32>(m_loadedCount + m_failedCount) / static_cast<f32>(m_handles.size());
+    }
+
+    bool ResourcePrefetch::is_complete() const
+    {
+        return m_loadedCount + m_failedCount >= m_handles.size();
     }
 
     void ResourceManager::initialise(const ResourceManagerInit& init)
@@ -63,38 +153,201 @@ namespace mill
         LOG_INFO("ResourceManager - Initialising...");
         m_resourcePath = init.resourcePath;
 
-        load_all_metadata();
+        load_all_metadata(init.useRegistry);
+
+        if (init.hotReload)
+        {
+            m_fileWatcher = CreateOwned<FileWatcher>(m_resourcePath);
+            if (!m_fileWatcher->is_watching())
+            {
+                LOG_WARN("ResourceManager - Hot-reload is unavailable. Failed to watch <{}>.", m_resourcePath.string());
+                m_fileWatcher = nullptr;
+            }
+        }
+
+        start_loader_threads(init.loaderThreadCount);
+
+        if (!init.traceFile.empty())
+        {
+            begin_trace(init.traceFile);
+        }
     }
 
     void ResourceManager::shutdown()
     {
         LOG_INFO("ResourceManager - Shutting down...");
+        stop_loader_threads();
+        end_trace();
+
+        m_fileWatcher = nullptr;
+        m_deferredFileChanges.clear();
+
         m_resourceLoadQueue = {};
+        m_queuedLoads.clear();
         m_pendingResources.clear();
-        m_resourceFactories.clear();
-        m_resourceCaches.clear();
+        m_releasedResources.clear();
+        m_prefetchWaiters.clear();
+        m_completedLoads.clear();
+        m_uploadingResources.clear();
+        m_resourceTypes.clear();
+        m_resourceTypeIndices.clear();
+        m_slots.clear();
+        m_freeSlots.clear();
+        m_dataBanks.clear();
         m_metadataMap.clear();
+        m_registry = nullptr;
+    }
+
+    void ResourceManager::tick()
+    {
+        std::vector<CompletedResourceLoad> completed_loads{};
+        {
+            std::lock_guard lock(m_loaderMutex);
+            std::swap(completed_loads, m_completedLoads);
+        }
+
+        for (auto& completed_load : completed_loads)
+        {
+            auto& metadata = get_metadata(completed_load.id);
+            if (completed_load.isReload)
+            {
+                if (completed_load.resource == nullptr || !metadata.isLoaded)
+                {
+                    if (completed_load.resource == nullptr)
+                    {
+                        LOG_WARN("ResourceManager - Failed to reload resource <{}>. Keeping the previous version.", completed_load.id);
+                    }
+
+                    std::lock_guard lock(m_loaderMutex);
+                    m_pendingResources.erase(completed_load.id);
+                    continue;
+                }
+
+                completed_load.times.uploadStarted = LoaderClock::now();
+                find_resource_type(metadata.typeId)->factory->on_loaded(*completed_load.resource);
+                m_uploadingResources.push_back({ completed_load.id, std::move(completed_load.resource), true, completed_load.times });
+                continue;
+            }
+
+            if (metadata.isLoaded)
+            {
+                // Resource was force loaded while it was in-flight
+                continue;
+            }
+
+            if (completed_load.resource == nullptr)
+            {
+                LOG_ERROR("ResourceManager - Failed to loaded resource <id = {}>!", completed_load.id);
+                {
+                    std::lock_guard lock(m_loaderMutex);
+                    m_pendingResources.erase(completed_load.id);
+                }
+                record_load(metadata, completed_load.times, false, false);
+                complete_prefetches(completed_load.id, false);
+                continue;
+            }
+
+            completed_load.times.uploadStarted = LoaderClock::now();
+            find_resource_type(metadata.typeId)->factory->on_loaded(*completed_load.resource);
+            m_uploadingResources.push_back({ completed_load.id, std::move(completed_load.resource), false, completed_load.times });
+        }
+
+        publish_uploaded_resources();
+        unload_released_resources();
+        evict_resources();
+
+        if (m_fileWatcher != nullptr)
+        {
+            // Banks must be replaced atomically (written to a temporary file, then renamed over the old one), so in-flight loads
+            // keep reading the previous file through their own reference to its mapping
+            process_file_changes();
+
+#if MILL_WINDOWS
+            // Unmap data banks nothing is loading from, so the asset browser can replace them (Windows does not allow replacing
+            // mapped files)
+            std::lock_guard lock(m_dataBankMutex);
+            std::erase_if(m_dataBanks, [](const auto& data_bank) { return data_bank.second.use_count() == 1; });
+#endif
+        }
+    }
+
+    void ResourceManager::set_cache_budget(ResourceTypeId resource_type_id, const ResourceCacheBudget& budget)
+    {
+        auto* resource_type = find_resource_type(resource_type_id);
+        ASSERT(resource_type != nullptr);
+        resource_type->cache->set_budget(budget);
+    }
+
+    bool ResourceManager::has_metadata(ResourceId id) const
+    {
+        return m_metadataMap.contains(id) || (m_registry != nullptr && m_registry->find(id) != nullptr);
     }
 
     auto ResourceManager::get_metadata(ResourceId id) -> ResourceMetadata&
     {
         ASSERT(id);
-        ASSERT(m_metadataMap.find(id) != m_metadataMap.end());
+        ASSERT(has_metadata(id));
+
+        const auto it = m_metadataMap.find(id);
+        if (it != m_metadataMap.end())
+        {
+            return it->second;
+        }
+
+        const auto* record = m_registry != nullptr ? m_registry->find(id) : nullptr;
+        if (record != nullptr)
+        {
+            return materialise_metadata(*record);
+        }
 
         return m_metadataMap[id];
     }
 
-    auto ResourceManager::get_handle(ResourceId id, bool force_load) -> ResourceHandle
+    void ResourceManager::reload_resource(ResourceId id)
+    {
+        ASSERT(id);
+        ASSERT(has_metadata(id));
+
+        if (!get_metadata(id).isLoaded)
+        {
+            // Will be loaded from its current data when next requested
+            return;
+        }
+
+        load_resources(std::span(&id, 1), ResourceLoadPriority::eVisible, true);
+    }
+
+    bool ResourceManager::begin_trace(const fs::path& filename)
+    {
+        if (!m_trace.open(filename))
+        {
+            return false;
+        }
+
+        m_trace.set_thread_name(g_MainThreadTraceId, "Main Thread");
+        for (u32 i = 0; i < CAST_U32(m_loaderThreads.size()); ++i)
+        {
+            m_trace.set_thread_name(i + 1, std::format("Resource Loader {}", i));
+        }
+        return true;
+    }
+
+    void ResourceManager::end_trace()
+    {
+        m_trace.close();
+    }
+
+    auto ResourceManager::get_handle(ResourceId id, ResourceLoadPriority priority) -> ResourceHandle
     {
         ASSERT(id);
-        ASSERT(m_metadataMap.find(id) != m_metadataMap.end());
+        ASSERT(has_metadata(id));
 
         const auto& metadata = get_metadata(id);
         if (!metadata.isLoaded)
         {
-            if (!force_load)
+            if (priority != ResourceLoadPriority::eImmediate)
             {
-                load_resource(id);
+                load_resource(id, priority);
             }
             else
             {
@@ -105,73 +358,268 @@ namespace mill
         return ResourceHandle(*this, id);
     }
 
+    auto ResourceManager::prefetch(std::span<const ResourceId> ids, ResourceLoadPriority priority) -> Shared<ResourcePrefetch>
+    {
+        auto prefetch = CreateShared<ResourcePrefetch>();
+
+        const auto closure = get_dependency_closure(ids);
+        prefetch->m_handles.reserve(closure.size());
+
+        std::vector<ResourceId> load_ids{};
+        for (const auto id : closure)
+        {
+            prefetch->m_handles.emplace_back(*this, id);
+            if (get_metadata(id).isLoaded)
+            {
+                ++prefetch->m_loadedCount;
+                continue;
+            }
+
+            load_ids.push_back(id);
+            m_prefetchWaiters[id].push_back(prefetch);
+        }
+
+        // Read each data bank front-to-back
+        std::sort(load_ids.begin(),
+                  load_ids.end(),
+                  [this](ResourceId lhs, ResourceId rhs)
+                  {
+                      const auto& lhs_metadata = get_metadata(lhs);
+                      const auto& rhs_metadata = get_metadata(rhs);
+                      if (lhs_metadata.binaryFile != rhs_metadata.binaryFile)
+                      {
+                          return lhs_metadata.binaryFile < rhs_metadata.binaryFile;
+                      }
+                      return lhs_metadata.binaryOffset < rhs_metadata.binaryOffset;
+                  });
+
+        if (priority == ResourceLoadPriority::eImmediate)
+        {
+            for (const auto id : load_ids)
+            {
+                force_load_resource(id);
+            }
+        }
+        else
+        {
+            load_resources(load_ids, priority);
+        }
+
+        LOG_DEBUG("ResourceManager - Prefetching {} resources ({} already loaded).", closure.size(), prefetch->m_loadedCount);
+        return prefetch;
+    }
+
     auto ResourceManager::get_resource(ResourceId id) -> Resource*
     {
         ASSERT(id);
-        ASSERT(m_metadataMap.contains(id));
+        ASSERT(has_metadata(id));
 
         const auto& metadata = get_metadata(id);
-        if (!metadata.isLoaded)
+        auto* resource_type = find_resource_type(metadata.typeId);
+        if (resource_type == nullptr)
+        {
+            LOG_ERROR("ResourceManager - Resource <{}> has unregistered resource type id {}!", id, metadata.typeId);
+            return nullptr;
+        }
+
+        auto* cache = resource_type->cache.get();
+        auto* resource = cache->get(id);
+        if (resource != nullptr)
+        {
+            return resource;
+        }
+
         {
+            std::lock_guard lock(m_loaderMutex);
             if (m_pendingResources.contains(id))
             {
                 return nullptr;
             }
+        }
 
-            force_load_resource(id);
-            if (!metadata.isLoaded)
+        force_load_resource(id);
+        return cache->find(id);
+    }
+
+    auto ResourceManager::get_loader_stats() const -> ResourceLoaderStats
+    {
+        std::lock_guard lock(m_loaderMutex);
+        auto stats = m_loaderStats;
+        stats.queueDepth = m_queuedLoads.size();
+        return stats;
+    }
+
+    auto ResourceManager::get_cache_stats(ResourceTypeId resource_type_id) const -> ResourceCacheStats
+    {
+        const auto* resource_type = find_resource_type(resource_type_id);
+        ASSERT(resource_type != nullptr);
+        return resource_type->cache->get_stats();
+    }
+
+    auto ResourceManager::get_type_stats(ResourceTypeId resource_type_id) const -> ResourceTypeStats
+    {
+        const auto* resource_type = find_resource_type(resource_type_id);
+        ASSERT(resource_type != nullptr);
+
+        ResourceTypeStats stats{};
+        stats.cache = resource_type->cache->get_stats();
+
+        {
+            // Pending resources always have their metadata materialised
+            std::lock_guard lock(m_loaderMutex);
+            for (const auto id : m_pendingResources)
             {
-                return nullptr;
+                const auto it = m_metadataMap.find(id);
+                if (it != m_metadataMap.end() && it->second.typeId == resource_type_id)
+                {
+                    ++stats.pendingCount;
+                }
             }
         }
 
-        ASSERT(m_resourceCaches.contains(metadata.typeId));
+        const auto& load_stats = resource_type->loadStats;
+        stats.loadedCount = load_stats.loadedCount;
+        stats.failedCount = load_stats.failedCount;
+        stats.maxLoadLatencyMs = load_stats.maxLatencyMs;
+        if (load_stats.loadedCount != 0)
+        {
+            stats.averageLoadLatencyMs = load_stats.totalLatencyMs / static_cast<f64>(load_stats.loadedCount);
+        }
+
+        if (!load_stats.recentLatenciesMs.empty())
+        {
+            auto sorted_latencies = load_stats.recentLatenciesMs;
+            std::sort(sorted_latencies.begin(), sorted_latencies.end());
+            stats.p50LoadLatencyMs = get_percentile(sorted_latencies, 0.5);
+            stats.p90LoadLatencyMs = get_percentile(sorted_latencies, 0.9);
+            stats.p99LoadLatencyMs = get_percentile(sorted_latencies, 0.99);
+        }
 
-        auto* cache = m_resourceCaches[metadata.typeId].get();
-        return cache->get(id);
+        return stats;
     }
 
-    void ResourceManager::load_all_metadata()
+    void ResourceManager::load_all_metadata(bool use_registry)
     {
+        const auto registry_filename = m_resourcePath / g_ResourceRegistryFilename;
+        if (use_registry && fs::exists(registry_filename))
+        {
+            m_registry = CreateOwned<ResourceRegistry>(registry_filename);
+            if (m_registry->is_valid())
+            {
+                LOG_INFO("ResourceManager - Using compiled resource registry <{}> ({} resources).",
+                         registry_filename.string(),
+                         m_registry->get_records().size());
+                return;
+            }
+
+            LOG_WARN("ResourceManager - Falling back to metadata banks.");
+            m_registry = nullptr;
+        }
+
         LOG_INFO("ResourceManager - Loading all resource metadata.");
+        const auto start_time = std::chrono::steady_clock::now();
 
         // Assume .yaml files hold resource metadata
+        std::vector<fs::path> metadata_files{};
         for (const auto& dir_entry : fs::recursive_directory_iterator(m_resourcePath))
         {
-            if (!dir_entry.is_regular_file())
+            if (dir_entry.is_regular_file() && dir_entry.path().extension() == g_MetadataFileExt)
             {
-                continue;
+                metadata_files.push_back(dir_entry.path());
             }
+        }
+        // Directory iteration order is unspecified, so sort to make which definition of a duplicated id wins the same everywhere
+        std::sort(metadata_files.begin(), metadata_files.end());
 
-            const auto path = dir_entry.path();
-            if (path.extension() != g_MetadataFileExt)
+        // Parse the files across a pool of threads. Each file is parsed into its own staging vector, so the threads never contend.
+        std::vector<std::vector<ResourceMetadata>> parsed_files(metadata_files.size());
+        std::atomic<sizet> next_file_index{ 0 };
+        const auto parse_files = [&]()
+        {
+            for (auto i = next_file_index++; i < metadata_files.size(); i = next_file_index++)
             {
-                continue;
+                try
+                {
+                    parsed_files[i] = parse_metadata_file(metadata_files[i]);
+                }
+                catch (const YAML::Exception& e)
+                {
+                    LOG_ERROR("ResourceManager - Failed to parse metadata bank <{}>: {}", metadata_files[i].string(), e.what());
+                }
             }
+        };
+
+        const auto thread_count = std::clamp<sizet>(std::thread::hardware_concurrency(), 1, std::max<sizet>(metadata_files.size(), 1));
+        std::vector<std::thread> parse_threads{};
+        parse_threads.reserve(thread_count - 1);
+        for (sizet i = 1; i < thread_count; ++i)
+        {
+            parse_threads.emplace_back(parse_files);
+        }
+        parse_files();
+        for (auto& thread : parse_threads)
+        {
+            thread.join();
+        }
+
+        // Merge in sorted file order, so which definition of a duplicated id wins does not depend on thread timing
+        sizet total_count = 0;
+        for (const auto& parsed_file : parsed_files)
+        {
+            total_count += parsed_file.size();
+        }
+        m_metadataMap.reserve(m_metadataMap.size() + total_count);
+
+        sizet duplicate_count = 0;
+        for (sizet i = 0; i < parsed_files.size(); ++i)
+        {
+            for (const auto& source : parsed_files[i])
+            {
+                const auto [it, inserted] = m_metadataMap.try_emplace(source.id);
+                if (!inserted)
+                {
+                    LOG_WARN("ResourceManager - Resource <{}> in <{}> is already defined (data bank <{}>). Ignoring it.",
+                             source.id,
+                             metadata_files[i].string(),
+                             it->second.binaryFile);
+                    ++duplicate_count;
+                    continue;
+                }
 
-            load_metadata_file(path);
+                update_metadata(it->second, source);
+            }
         }
+
+        const std::chrono::duration<f64, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+        LOG_INFO("ResourceManager - Loaded metadata for {} resources from {} metadata banks in {:.2f}ms ({} threads, {} duplicates).",
+                 m_metadataMap.size(),
+                 metadata_files.size(),
+                 elapsed.count(),
+                 thread_count,
+                 duplicate_count);
     }
 
-    void ResourceManager::load_metadata_file(const fs::path& filename)
+    auto ResourceManager::parse_metadata_file(const fs::path& filename) -> std::vector<ResourceMetadata>
     {
+        std::vector<ResourceMetadata> resources{};
+
         const YAML::Node rootNode = YAML::LoadFile(filename.string());
         if (rootNode.IsNull() || !rootNode["resources"])
         {
-            return;
+            return resources;
         }
 
         const auto& resourceNode = rootNode["resources"];
         if (resourceNode.IsNull())
         {
             LOG_WARN("ResourceManager - <{}> does not hold any metadata.", filename.string());
-            return;
+            return resources;
         }
 
         if (!resourceNode.IsSequence())
         {
             LOG_WARN("ResourceManager - 'resources' node is not a YAML Sequence. <{}>", filename.string());
-            return;
+            return resources;
         }
 
         for (const auto& metadataNode : resourceNode)
@@ -193,65 +641,840 @@ namespace mill
             auto flags = flagsNode.as<i32>();
             UNUSED(flags);
 
-            auto& metadata = m_metadataMap[id];
+            auto& metadata = resources.emplace_back();
             metadata.id = id;
+            if (metadataNode["type"])
+            {
+                metadata.typeId = metadataNode["type"].as<ResourceTypeId>();
+            }
             metadata.binaryFile = (filename.parent_path() / metadataNode["data_bank"].as<std::string>()).string();
             metadata.binaryOffset = metadataNode["data_offset"].as<u64>();
             metadata.binarySize = metadataNode["data_size"].as<u64>();
+            metadata.uncompressedSize = metadata.binarySize;
+            if (metadataNode["codec"])
+            {
+                metadata.codec = static_cast<CompressionCodec>(metadataNode["codec"].as<u32>());
+                metadata.uncompressedSize = metadataNode["uncompressed_size"].as<u64>();
+            }
             metadata.flags = ResourceFlags(metadataNode["flags"].as<ResourceFlags::MaskType>());
+            if (metadataNode["dependencies"])
+            {
+                metadata.dependencies = metadataNode["dependencies"].as<std::vector<ResourceId>>();
+            }
 
-            LOG_DEBUG("ResourceManager - Metadata - Id = {}, BinaryFile = <{}>, BinaryOffset = {}, BinarySize = {}, Flags = {}",
+            LOG_TRACE("ResourceManager - Metadata - Id = {}, BinaryFile = <{}>, BinaryOffset = {}, BinarySize = {}, Flags = {}",
                       metadata.id,
                       metadata.binaryFile,
                       metadata.binaryOffset,
                       metadata.binarySize,
                       static_cast<ResourceFlags::MaskType>(metadata.flags));
         }
+
+        return resources;
     }
 
-    void ResourceManager::load_resource(ResourceId id)
+    auto ResourceManager::materialise_metadata(const ResourceRegistryRecord& record) -> ResourceMetadata&
     {
-        ASSERT(id);
-        ASSERT(m_metadataMap.find(id) != m_metadataMap.end());
+        auto& metadata = m_metadataMap[record.id];
+        update_metadata(metadata, make_metadata(*m_registry, record));
+        return metadata;
+    }
+
+    auto ResourceManager::make_metadata(const ResourceRegistry& registry, const ResourceRegistryRecord& record) const -> ResourceMetadata
+    {
+        ResourceMetadata metadata{};
+        metadata.id = record.id;
+        metadata.typeId = record.typeId;
+        metadata.binaryFile = (m_resourcePath / registry.get_bank_name(record.bankIndex)).string();
+        metadata.binaryOffset = record.binaryOffset;
+        metadata.binarySize = record.binarySize;
+        metadata.uncompressedSize = record.uncompressedSize;
+        metadata.codec = record.codec;
+        metadata.flags = ResourceFlags(record.flags);
+
+        const auto dependencies = registry.get_dependencies(record);
+        metadata.dependencies.assign(dependencies.begin(), dependencies.end());
+        return metadata;
+    }
+
+    bool ResourceManager::update_metadata(ResourceMetadata& metadata, const ResourceMetadata& source)
+    {
+        const bool data_changed = metadata.binaryFile != source.binaryFile || metadata.binaryOffset != source.binaryOffset ||
+                                  metadata.binarySize != source.binarySize || metadata.uncompressedSize != source.uncompressedSize ||
+                                  metadata.codec != source.codec;
+
+        metadata.id = source.id;
+        metadata.typeId = source.typeId;
+        metadata.binaryFile = source.binaryFile;
+        metadata.binaryOffset = source.binaryOffset;
+        metadata.binarySize = source.binarySize;
+        metadata.uncompressedSize = source.uncompressedSize;
+        metadata.codec = source.codec;
+        metadata.flags = source.flags;
+        metadata.dependencies = source.dependencies;
+        return data_changed;
+    }
+
+    void ResourceManager::load_resource(ResourceId id, ResourceLoadPriority priority)
+    {
+        load_resources(std::span(&id, 1), priority);
+    }
 
-        if (m_pendingResources.contains(id))
+    void ResourceManager::load_resources(std::span<const ResourceId> ids, ResourceLoadPriority priority, bool is_reload)
+    {
+        std::vector<const ResourceMetadata*> metadatas{};
+        metadatas.reserve(ids.size());
+        for (const auto id : ids)
         {
-            return;
+            ASSERT(id);
+            ASSERT(has_metadata(id));
+            metadatas.push_back(&get_metadata(id));
+        }
+
+        u32 queued_count{};
+        {
+            std::lock_guard lock(m_loaderMutex);
+            const auto queued_time = LoaderClock::now();
+            for (const auto* metadata : metadatas)
+            {
+                const auto queued_it = m_queuedLoads.find(metadata->id);
+                if (queued_it != m_queuedLoads.end())
+                {
+                    // Already queued, move it up if it is now needed sooner
+                    auto& queued_request = queued_it->second;
+                    if (priority < queued_request.priority)
+                    {
+                        queued_request.priority = priority;
+                        queued_request.sequence = m_nextLoadSequence++;
+                        m_resourceLoadQueue.push(queued_request);
+                        ++queued_count;
+                    }
+                    continue;
+                }
+
+                if (!m_pendingResources.emplace(metadata->id).second)
+                {
+                    // Already being loaded
+                    continue;
+                }
+
+                const ResourceLoadRequest request{ metadata->id, metadata, queued_time, is_reload, priority, m_nextLoadSequence++ };
+                m_resourceLoadQueue.push(request);
+                m_queuedLoads[metadata->id] = request;
+                ++queued_count;
+            }
+            m_loaderStats.maxQueueDepth = std::max<u64>(m_loaderStats.maxQueueDepth, m_queuedLoads.size());
+        }
+
+        if (queued_count == 1)
+        {
+            m_loaderCondition.notify_one();
+            LOG_DEBUG("ResourceManager - Resource <{}> marked for loading.", ids.front());
+        }
+        else if (queued_count > 1)
+        {
+            m_loaderCondition.notify_all();
+            LOG_DEBUG("ResourceManager - {} resources marked for loading.", queued_count);
+        }
+    }
+
+    bool ResourceManager::cancel_load(ResourceId id)
+    {
+        std::lock_guard lock(m_loaderMutex);
+        if (m_queuedLoads.erase(id) == 0)
+        {
+            return false;
         }
 
-        m_pendingResources.emplace(id);
-        m_resourceLoadQueue.push(id);
-        LOG_DEBUG("ResourceManager - Resource <{}> marked for loading.", id);
+        m_pendingResources.erase(id);
+        ++m_loaderStats.cancelledCount;
+        return true;
     }
 
     void ResourceManager::force_load_resource(ResourceId id)
     {
         ASSERT(id);
-        ASSERT(m_metadataMap.contains(id));
+        ASSERT(has_metadata(id));
 
         LOG_DEBUG("ResourceManager - Force loading <{}>.", id);
 
-        auto& metadata = get_metadata(id);
-        if (!m_resourceFactories.contains(metadata.typeId))
         {
-            LOG_ERROR("ResourceManager - No factory registered to resource type id {}!", metadata.typeId);
-            return;
+            // No need for the loader threads to load it too
+            std::lock_guard lock(m_loaderMutex);
+            if (m_queuedLoads.erase(id) != 0)
+            {
+                m_pendingResources.erase(id);
+            }
         }
 
-        auto* factory = m_resourceFactories[metadata.typeId].get();
-        auto resource = factory->load(metadata);
+        auto& metadata = get_metadata(id);
+
+        ResourceLoadTimes times{};
+        times.queued = LoaderClock::now();
+        times.started = times.queued;
+
+        Shared<MappedFile> data_bank{ nullptr };
+        std::vector<std::byte> decompressed_data{};
+        auto resource = load_resource_data(metadata, data_bank, decompressed_data, times);
+        trace_load(metadata, times, g_MainThreadTraceId);
         if (resource == nullptr)
         {
             metadata.isLoaded = false;
             LOG_ERROR("ResourceManager - Failed to loaded resource <id = {}>!", id);
+            record_load(metadata, times, false, false);
+            complete_prefetches(id, false);
             return;
         }
 
-        auto* cache = m_resourceCaches[metadata.typeId].get();
-        cache->add(id, std::move(resource));
+        times.uploadStarted = LoaderClock::now();
+        auto& factory = *find_resource_type(metadata.typeId)->factory;
+        factory.on_loaded(*resource);
+        factory.wait_until_ready(*resource);
+        publish_resource(metadata, std::move(resource));
+        record_load(metadata, times, true, false);
+    }
 
-        metadata.isLoaded = true;
-        m_pendingResources.erase(id);
+    auto ResourceManager::get_data_bank(const std::string& filename) -> Shared<MappedFile>
+    {
+        std::lock_guard lock(m_dataBankMutex);
+
+        auto& data_bank = m_dataBanks[filename];
+        if (data_bank == nullptr)
+        {
+            LOG_DEBUG("ResourceManager - Mapping data bank <{}>.", filename);
+            data_bank = CreateShared<MappedFile>(filename);
+        }
+
+        return data_bank;
+    }
+
+    void ResourceManager::release_data_bank(const fs::path& filename)
+    {
+        std::lock_guard lock(m_dataBankMutex);
+        std::erase_if(m_dataBanks, [&](const auto& data_bank) { return is_same_file(data_bank.first, filename); });
+    }
+
+    auto ResourceManager::load_resource_data(const ResourceMetadata& metadata,
+                                             Shared<MappedFile>& data_bank,
+                                             std::vector<std::byte>& decompressed_data,
+                                             ResourceLoadTimes& times) -> Owned<Resource>
+    {
+        auto* resource_type = find_resource_type(metadata.typeId);
+        if (resource_type == nullptr)
+        {
+            LOG_ERROR("ResourceManager - No factory registered to resource type id {}!", metadata.typeId);
+            return nullptr;
+        }
+
+        data_bank = get_data_bank(metadata.binaryFile);
+        if (!data_bank->is_open())
+        {
+            LOG_ERROR("ResourceManager - Failed to open data bank <{}> for resource <{}>!", metadata.binaryFile, metadata.id);
+            return nullptr;
+        }
+
+        std::span<const std::byte> data = data_bank->get_slice(metadata.binaryOffset, metadata.binarySize);
+        if (data.empty())
+        {
+            LOG_ERROR("ResourceManager - Resource <{}> does not lie within its data bank <{}> (offset = {}, size = {}, bank size = {})!",
+                      metadata.id,
+                      metadata.binaryFile,
+                      metadata.binaryOffset,
+                      metadata.binarySize,
+                      data_bank->get_size());
+            return nullptr;
+        }
+
+        if (metadata.codec != CompressionCodec::eNone)
+        {
+            decompressed_data.resize(metadata.uncompressedSize);
+            if (!decompress(metadata.codec, data, decompressed_data))
+            {
+                LOG_ERROR("ResourceManager - Failed to decompress resource <{}> ({}, {}B -> {}B)!",
+                          metadata.id,
+                          get_codec_name(metadata.codec),
+                          metadata.binarySize,
+                          metadata.uncompressedSize);
+                return nullptr;
+            }
+            data = decompressed_data;
+        }
+        times.dataRead = LoaderClock::now();
+
+        auto resource = resource_type->factory->load(metadata, data);
+        times.decoded = LoaderClock::now();
+        return resource;
+    }
+
+    void ResourceManager::publish_resource(ResourceMetadata& metadata, Owned<Resource> resource)
+    {
+        ASSERT(resource != nullptr);
+
+        // The resource is moved into its caches storage, so only use it through the pointer returned
+        auto* resource_ptr = find_resource_type(metadata.typeId)->cache->add(metadata.id, std::move(resource));
+        metadata.slot = allocate_slot(resource_ptr);
+        metadata.isLoaded = true;
+
+        {
+            std::lock_guard lock(m_loaderMutex);
+            m_pendingResources.erase(metadata.id);
+        }
+
+        complete_prefetches(metadata.id, true);
+    }
+
+    void ResourceManager::publish_uploaded_resources()
+    {
+        for (auto it = m_uploadingResources.begin(); it != m_uploadingResources.end();)
+        {
+            auto& metadata = get_metadata(it->id);
+            auto& factory = *find_resource_type(metadata.typeId)->factory;
+            if (!factory.is_ready(*it->resource))
+            {
+                ++it;
+                continue;
+            }
+
+            auto resource = std::move(it->resource);
+            const bool is_reload = it->isReload;
+            const auto times = it->times;
+            it = m_uploadingResources.erase(it);
+
+            if (is_reload)
+            {
+                {
+                    std::lock_guard lock(m_loaderMutex);
+                    m_pendingResources.erase(metadata.id);
+                }
+
+                if (metadata.isLoaded)
+                {
+                    replace_resource(metadata, std::move(resource));
+                    record_load(metadata, times, true, true);
+                }
+                else
+                {
+                    // Unloaded while the new version was uploading
+                    factory.on_unloaded(*resource);
+                }
+                continue;
+            }
+
+            if (metadata.isLoaded)
+            {
+                // Resource was force loaded while it was uploading
+                factory.on_unloaded(*resource);
+                continue;
+            }
+
+            publish_resource(metadata, std::move(resource));
+            record_load(metadata, times, true, false);
+            if (metadata.refCount.get_count() == 0)
+            {
+                // Every handle was released while the resource was loading
+                on_last_reference_released(metadata.id);
+            }
+        }
+    }
+
+    void ResourceManager::replace_resource(ResourceMetadata& metadata, Owned<Resource> resource)
+    {
+        ASSERT(resource != nullptr);
+        ASSERT(metadata.isLoaded);
+
+        auto& resource_type = *find_resource_type(metadata.typeId);
+
+        // The new version takes the place of the previous one in the caches storage, so the slot (and existing handles) still
+        // resolve to it
+        auto previous_resource = resource_type.cache->replace(metadata.id, std::move(resource));
+        resource_type.factory->on_unloaded(*previous_resource);
+        ASSERT(m_slots[metadata.slot.index].resource == resource_type.cache->find(metadata.id));
+
+        LOG_INFO("ResourceManager - Reloaded resource <{}>.", metadata.id);
+    }
+
+    void ResourceManager::process_file_changes()
+    {
+        auto changed_files = m_fileWatcher->poll();
+        changed_files.insert(changed_files.end(), m_deferredFileChanges.begin(), m_deferredFileChanges.end());
+        m_deferredFileChanges.clear();
+
+        std::sort(changed_files.begin(), changed_files.end());
+        changed_files.erase(std::unique(changed_files.begin(), changed_files.end()), changed_files.end());
+
+        // Apply metadata changes first, so data banks are reloaded with their new offsets/sizes
+        std::stable_partition(changed_files.begin(),
+                              changed_files.end(),
+                              [](const auto& filename)
+                              { return filename.filename() == g_ResourceRegistryFilename || filename.extension() == g_MetadataFileExt; });
+
+        for (const auto& filename : changed_files)
+        {
+            bool applied{ true };
+            if (filename.filename() == g_ResourceRegistryFilename)
+            {
+                if (m_registry != nullptr)
+                {
+                    applied = reload_registry();
+                }
+            }
+            else if (filename.extension() == g_MetadataFileExt)
+            {
+                // The registry is built from the metadata banks, so takes precedence when in use
+                if (m_registry == nullptr)
+                {
+                    applied = reload_metadata_file(filename);
+                }
+            }
+            else
+            {
+                reload_data_bank(filename);
+            }
+
+            if (!applied)
+            {
+                m_deferredFileChanges.push_back(filename);
+            }
+        }
+    }
+
+    bool ResourceManager::reload_registry()
+    {
+        {
+            std::lock_guard lock(m_loaderMutex);
+            if (!m_pendingResources.empty())
+            {
+                return false;
+            }
+        }
+
+        const auto registry_filename = m_resourcePath / g_ResourceRegistryFilename;
+        auto registry = CreateOwned<ResourceRegistry>(registry_filename);
+        if (!registry->is_valid())
+        {
+            LOG_WARN("ResourceManager - Changed resource registry <{}> is not valid. Keeping the previous one.", registry_filename.string());
+            return true;
+        }
+
+        std::vector<ResourceId> reload_ids{};
+        for (auto& [id, metadata] : m_metadataMap)
+        {
+            const auto* record = registry->find(id);
+            if (record != nullptr && update_metadata(metadata, make_metadata(*registry, *record)) && metadata.isLoaded)
+            {
+                release_data_bank(metadata.binaryFile);
+                reload_ids.push_back(id);
+            }
+        }
+        m_registry = std::move(registry);
+
+        LOG_INFO("ResourceManager - Resource registry changed, reloading {} resources.", reload_ids.size());
+        load_resources(reload_ids, ResourceLoadPriority::eVisible, true);
+        return true;
+    }
+
+    bool ResourceManager::reload_metadata_file(const fs::path& filename)
+    {
+        std::vector<ResourceMetadata> resources{};
+        try
+        {
+            resources = parse_metadata_file(filename);
+        }
+        catch (const YAML::Exception& e)
+        {
+            LOG_WARN("ResourceManager - Failed to parse changed metadata bank <{}>: {}", filename.string(), e.what());
+            return true;
+        }
+
+        {
+            std::lock_guard lock(m_loaderMutex);
+            for (const auto& source : resources)
+            {
+                if (m_pendingResources.contains(source.id))
+                {
+                    return false;
+                }
+            }
+        }
+
+        std::vector<ResourceId> reload_ids{};
+        for (const auto& source : resources)
+        {
+            auto& metadata = m_metadataMap[source.id];
+            if (update_metadata(metadata, source) && metadata.isLoaded)
+            {
+                release_data_bank(metadata.binaryFile);
+                reload_ids.push_back(source.id);
+            }
+        }
+
+        LOG_INFO("ResourceManager - Metadata bank <{}> changed, reloading {} resources.", filename.string(), reload_ids.size());
+        load_resources(reload_ids, ResourceLoadPriority::eVisible, true);
+        return true;
+    }
+
+    void ResourceManager::reload_data_bank(const fs::path& filename)
+    {
+        release_data_bank(filename);
+
+        std::vector<ResourceId> reload_ids{};
+        for (const auto& [id, metadata] : m_metadataMap)
+        {
+            if (metadata.isLoaded && is_same_file(metadata.binaryFile, filename))
+            {
+                reload_ids.push_back(id);
+            }
+        }
+
+        if (!reload_ids.empty())
+        {
+            LOG_INFO("ResourceManager - Data bank <{}> changed, reloading {} resources.", filename.string(), reload_ids.size());
+            load_resources(reload_ids, ResourceLoadPriority::eVisible, true);
+        }
+    }
+
+    void ResourceManager::trace_load(const ResourceMetadata& metadata, const ResourceLoadTimes& times, u32 thread_id)
+    {
+        if (!m_trace.is_open())
+        {
+            return;
+        }
+
+        const auto args = std::format(R"({{"id":{},"type":{},"size":{}}})", metadata.id, metadata.typeId, metadata.binarySize);
+        m_trace.add_async_event("Queue Wait", "resources", metadata.id, times.queued, times.started, args);
+
+        // A failed load may not have reached every stage
+        if (times.dataRead != LoaderClock::time_point{})
+        {
+            m_trace.add_complete_event("I/O", "resources", thread_id, times.started, times.dataRead, args);
+        }
+        if (times.decoded != LoaderClock::time_point{})
+        {
+            m_trace.add_complete_event("Decode", "resources", thread_id, times.dataRead, times.decoded, args);
+        }
+    }
+
+    void ResourceManager::record_load(const ResourceMetadata& metadata, const ResourceLoadTimes& times, bool loaded, bool is_reload)
+    {
+        const auto now = LoaderClock::now();
+        if (loaded && m_trace.is_open())
+        {
+            const auto args = std::format(R"({{"id":{},"type":{},"reload":{}}})", metadata.id, metadata.typeId, is_reload);
+            m_trace.add_async_event("Upload", "resources", metadata.id, times.uploadStarted, now, args);
+        }
+
+        if (is_reload)
+        {
+            return;
+        }
+
+        auto* resource_type = find_resource_type(metadata.typeId);
+        if (resource_type == nullptr)
+        {
+            return;
+        }
+
+        auto& stats = resource_type->loadStats;
+        if (!loaded)
+        {
+            ++stats.failedCount;
+            return;
+        }
+
+        const std::chrono::duration<f64, std::milli> latency = now - times.queued;
+        ++stats.loadedCount;
+        stats.totalLatencyMs += latency.count();
+        stats.maxLatencyMs = std::max(stats.maxLatencyMs, latency.count());
+
+        if (stats.recentLatenciesMs.size() < g_LatencySampleCount)
+        {
+            stats.recentLatenciesMs.push_back(latency.count());
+        }
+        else
+        {
+            stats.recentLatenciesMs[stats.nextLatencyIndex] = latency.count();
+            stats.nextLatencyIndex = (stats.nextLatencyIndex + 1) % g_LatencySampleCount;
+        }
+    }
+
+    auto ResourceManager::find_resource_type(ResourceTypeId resource_type_id) -> ResourceTypeEntry*
+    {
+        const auto it = m_resourceTypeIndices.find(resource_type_id);
+        return it != m_resourceTypeIndices.end() ? &m_resourceTypes[it->second] : nullptr;
+    }
+
+    auto ResourceManager::find_resource_type(ResourceTypeId resource_type_id) const -> const ResourceTypeEntry*
+    {
+        const auto it = m_resourceTypeIndices.find(resource_type_id);
+        return it != m_resourceTypeIndices.end() ? &m_resourceTypes[it->second] : nullptr;
+    }
+
+    void ResourceManager::evict_resources()
+    {
+        for (auto& resource_type : m_resourceTypes)
+        {
+            auto* cache = resource_type.cache.get();
+            if (cache == nullptr || !cache->is_over_budget())
+            {
+                continue;
+            }
+
+            const auto can_evict = [this](ResourceId id)
+            {
+                const auto& metadata = get_metadata(id);
+                if (static_cast<bool>(metadata.flags & ResourceFlagBits::eKeepLoaded))
+                {
+                    return false;
+                }
+
+                return metadata.refCount.get_count() == 0;
+            };
+
+            const auto evicted_ids = cache->get_eviction_candidates(can_evict);
+            for (const auto id : evicted_ids)
+            {
+                unload_resource(get_metadata(id), *cache);
+            }
+        }
+    }
+
+    auto ResourceManager::get_dependency_closure(std::span<const ResourceId> ids) -> std::vector<ResourceId>
+    {
+        std::vector<ResourceId> closure{};
+        std::unordered_set<ResourceId> visited{};
+        std::vector<ResourceId> to_visit(ids.rbegin(), ids.rend());
+        while (!to_visit.empty())
+        {
+            const auto id = to_visit.back();
+            to_visit.pop_back();
+            if (!visited.insert(id).second)
+            {
+                continue;
+            }
+
+            if (!has_metadata(id))
+            {
+                LOG_WARN("ResourceManager - Resource <{}> does not exist. It will not be loaded.", id);
+                continue;
+            }
+
+            closure.push_back(id);
+
+            const auto& dependencies = get_metadata(id).dependencies;
+            to_visit.insert(to_visit.end(), dependencies.rbegin(), dependencies.rend());
+        }
+
+        return closure;
+    }
+
+    void ResourceManager::complete_prefetches(ResourceId id, bool loaded)
+    {
+        const auto it = m_prefetchWaiters.find(id);
+        if (it == m_prefetchWaiters.end())
+        {
+            return;
+        }
+
+        for (const auto& weak_prefetch : it->second)
+        {
+            const auto prefetch = weak_prefetch.lock();
+            if (prefetch == nullptr)
+            {
+                continue;
+            }
+
+            if (loaded)
+            {
+                ++prefetch->m_loadedCount;
+            }
+            else
+            {
+                ++prefetch->m_failedCount;
+            }
+        }
+        m_prefetchWaiters.erase(it);
+    }
+
+    void ResourceManager::on_last_reference_released(ResourceId id)
+    {
+        std::lock_guard lock(m_releasedMutex);
+        m_releasedResources.push_back(id);
+    }
+
+    void ResourceManager::unload_released_resources()
+    {
+        std::vector<ResourceId> released_resources{};
+        {
+            std::lock_guard lock(m_releasedMutex);
+            std::swap(released_resources, m_releasedResources);
+        }
+
+        for (const auto id : released_resources)
+        {
+            auto& metadata = get_metadata(id);
+            if (metadata.refCount.get_count() != 0)
+            {
+                // A new handle has been created since
+                continue;
+            }
+
+            if (!metadata.isLoaded)
+            {
+                if (cancel_load(id))
+                {
+                    m_prefetchWaiters.erase(id);
+                    LOG_DEBUG("ResourceManager - Cancelled loading resource <{}>, it is no longer referenced.", id);
+                }
+                continue;
+            }
+
+            if (static_cast<bool>(metadata.flags & ResourceFlagBits::eKeepLoaded))
+            {
+                continue;
+            }
+
+            auto& cache = *find_resource_type(metadata.typeId)->cache;
+            if (cache.has_budget())
+            {
+                // Stays resident until the cache needs the space. Handles resolve through the slot table, so mark it as used now.
+                cache.touch(metadata.id);
+                continue;
+            }
+
+            unload_resource(metadata, cache);
+        }
+    }
+
+    void ResourceManager::unload_resource(ResourceMetadata& metadata, ResourceCache& cache)
+    {
+        auto resource = cache.evict(metadata.id);
+        if (resource == nullptr)
+        {
+            return;
+        }
+
+        find_resource_type(metadata.typeId)->factory->on_unloaded(*resource);
+        free_slot(metadata.slot);
+        metadata.slot = {};
+        metadata.isLoaded = false;
+
+        LOG_DEBUG("ResourceManager - Unloaded resource <{}>.", metadata.id);
+    }
+
+    auto ResourceManager::allocate_slot(Resource* resource) -> ResourceSlot
+    {
+        ASSERT(resource != nullptr);
+
+        u32 index{};
+        if (!m_freeSlots.empty())
+        {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            index = CAST_U32(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        auto& entry = m_slots[index];
+        entry.resource = resource;
+        return { index, entry.generation };
+    }
+
+    void ResourceManager::free_slot(ResourceSlot slot)
+    {
+        ASSERT(slot.index < m_slots.size());
+
+        auto& entry = m_slots[slot.index];
+        ASSERT(entry.generation == slot.generation);
+        entry.resource = nullptr;
+        ++entry.generation;
+        m_freeSlots.push_back(slot.index);
+    }
+
+    void ResourceManager::start_loader_threads(u32 thread_count)
+    {
+        thread_count = std::max(1u, thread_count);
+        LOG_INFO("ResourceManager - Starting {} resource loader thread(s).", thread_count);
+
+        m_stopLoaderThreads = false;
+        m_loaderThreads.reserve(thread_count);
+        for (u32 i = 0; i < thread_count; ++i)
+        {
+            m_loaderThreads.emplace_back([this, i] { loader_thread_func(i + 1); });
+        }
+    }
+
+    void ResourceManager::stop_loader_threads()
+    {
+        {
+            std::lock_guard lock(m_loaderMutex);
+            m_stopLoaderThreads = true;
+        }
+        m_loaderCondition.notify_all();
+
+        for (auto& thread : m_loaderThreads)
+        {
+            thread.join();
+        }
+        m_loaderThreads.clear();
+    }
+
+    void ResourceManager::loader_thread_func(u32 thread_id)
+    {
+        while (true)
+        {
+            ResourceLoadRequest request{};
+            {
+                std::unique_lock lock(m_loaderMutex);
+                m_loaderCondition.wait(lock, [this] { return m_stopLoaderThreads || !m_resourceLoadQueue.empty(); });
+                if (m_stopLoaderThreads)
+                {
+                    return;
+                }
+
+                request = m_resourceLoadQueue.top();
+                m_resourceLoadQueue.pop();
+
+                // Skip requests that have been cancelled, or superseded by a higher priority request for the same resource
+                const auto queued_it = m_queuedLoads.find(request.id);
+                if (queued_it == m_queuedLoads.end() || queued_it->second.sequence != request.sequence)
+                {
+                    continue;
+                }
+                m_queuedLoads.erase(queued_it);
+
+                ++m_loaderStats.inFlightCount;
+            }
+
+            ResourceLoadTimes times{};
+            times.queued = request.queuedTime;
+            times.started = LoaderClock::now();
+
+            Shared<MappedFile> data_bank{ nullptr };
+            std::vector<std::byte> decompressed_data{};
+            auto resource = load_resource_data(*request.metadata, data_bank, decompressed_data, times);
+            trace_load(*request.metadata, times, thread_id);
+
+            const std::chrono::duration<f64, std::milli> latency = LoaderClock::now() - request.queuedTime;
+
+            std::lock_guard lock(m_loaderMutex);
+            --m_loaderStats.inFlightCount;
+            if (resource != nullptr)
+            {
+                ++m_loaderStats.loadedCount;
+            }
+            else
+            {
+                ++m_loaderStats.failedCount;
+            }
+            m_loaderStats.totalLoadLatencyMs += latency.count();
+            m_loaderStats.maxLoadLatencyMs = std::max(m_loaderStats.maxLoadLatencyMs, latency.count());
+
+            m_completedLoads.push_back(
+                { request.id, std::move(resource), std::move(data_bank), std::move(decompressed_data), request.isReload, times });
+        }
     }
 
 }
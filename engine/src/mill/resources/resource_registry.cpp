@@ -0,0 +1,193 @@
+#include "mill/resources/resource_registry.hpp"
+
+#include "mill/io/binary_writer.hpp"
+#include "mill/io/memory_reader.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace mill
+{
+    ResourceRegistry::ResourceRegistry(const std::filesystem::path& filename) : m_file(filename)
+    {
+        if (!m_file.is_open())
+        {
+            return;
+        }
+
+        MemoryReader reader(m_file.get_data());
+
+        ResourceRegistryHeader header{};
+        reader.read_array(std::span(&header, 1));
+        if (reader.has_overrun() || header.magic != g_ResourceRegistryMagic || header.version != g_ResourceRegistryVersion)
+        {
+            LOG_ERROR("ResourceRegistry - <{}> is not a valid resource registry.", filename.string());
+            return;
+        }
+
+        const auto record_bytes = m_file.get_slice(header.recordsOffset, sizeof(ResourceRegistryRecord) * header.recordCount);
+        if (record_bytes.size() != sizeof(ResourceRegistryRecord) * header.recordCount ||
+            reinterpret_cast<uintptr_t>(record_bytes.data()) % alignof(ResourceRegistryRecord) != 0)
+        {
+            LOG_ERROR("ResourceRegistry - <{}> records are truncated or misaligned.", filename.string());
+            return;
+        }
+        m_records = { reinterpret_cast<const ResourceRegistryRecord*>(record_bytes.data()), header.recordCount };
+
+        const auto dependency_bytes = m_file.get_slice(header.dependenciesOffset, sizeof(ResourceId) * header.dependencyCount);
+        if (dependency_bytes.size() != sizeof(ResourceId) * header.dependencyCount ||
+            reinterpret_cast<uintptr_t>(dependency_bytes.data()) % alignof(ResourceId) != 0)
+        {
+            LOG_ERROR("ResourceRegistry - <{}> dependencies are truncated or misaligned.", filename.string());
+            return;
+        }
+        m_dependencies = { reinterpret_cast<const ResourceId*>(dependency_bytes.data()), header.dependencyCount };
+
+        const auto invalid_record_it = std::find_if(m_records.begin(),
+                                                    m_records.end(),
+                                                    [&](const auto& record)
+                                                    { return u64(record.firstDependency) + record.dependencyCount > m_dependencies.size(); });
+        if (invalid_record_it != m_records.end())
+        {
+            LOG_ERROR("ResourceRegistry - <{}> resource <{}> has out of range dependencies.", filename.string(), invalid_record_it->id);
+            return;
+        }
+
+        reader = MemoryReader(m_file.get_data());
+        reader.skip_bytes(header.banksOffset);
+        m_bankNames.reserve(header.bankCount);
+        for (u32 i = 0; i < header.bankCount; ++i)
+        {
+            const auto length = reader.read_u32();
+            const auto name = reader.view_bytes(length);
+            m_bankNames.emplace_back(reinterpret_cast<const char*>(name.data()), name.size());
+        }
+
+        if (reader.has_overrun())
+        {
+            LOG_ERROR("ResourceRegistry - <{}> data bank names are truncated.", filename.string());
+            return;
+        }
+
+        m_isValid = true;
+    }
+
+    bool ResourceRegistry::write(const std::filesystem::path& filename, std::span<const ResourceMetadata> resources)
+    {
+        std::vector<std::string> bank_names{};
+        std::unordered_map<std::string, u16> bank_indices{};
+
+        std::vector<const ResourceMetadata*> sorted_resources{};
+        sorted_resources.reserve(resources.size());
+        for (const auto& metadata : resources)
+        {
+            sorted_resources.push_back(&metadata);
+        }
+        std::sort(sorted_resources.begin(), sorted_resources.end(), [](const auto* lhs, const auto* rhs) { return lhs->id < rhs->id; });
+
+        std::vector<ResourceRegistryRecord> records{};
+        std::vector<ResourceId> dependencies{};
+        records.reserve(resources.size());
+        for (const auto* resource : sorted_resources)
+        {
+            const auto& metadata = *resource;
+
+            auto [bank_it, inserted] = bank_indices.try_emplace(metadata.binaryFile, CAST_U16(bank_names.size()));
+            if (inserted)
+            {
+                bank_names.push_back(metadata.binaryFile);
+            }
+
+            auto& record = records.emplace_back();
+            record.id = metadata.id;
+            record.binaryOffset = metadata.binaryOffset;
+            record.binarySize = metadata.binarySize;
+            record.typeId = metadata.typeId;
+            record.bankIndex = bank_it->second;
+            record.flags = static_cast<ResourceFlags::MaskType>(metadata.flags);
+            record.codec = metadata.codec;
+            record.uncompressedSize = metadata.uncompressedSize;
+            record.firstDependency = CAST_U32(dependencies.size());
+            record.dependencyCount = CAST_U32(metadata.dependencies.size());
+            dependencies.insert(dependencies.end(), metadata.dependencies.begin(), metadata.dependencies.end());
+        }
+
+        const auto duplicate_it =
+            std::adjacent_find(records.begin(), records.end(), [](const auto& lhs, const auto& rhs) { return lhs.id == rhs.id; });
+        if (duplicate_it != records.end())
+        {
+            LOG_ERROR("ResourceRegistry - Resource id {} is used by more than one resource.", duplicate_it->id);
+            return false;
+        }
+
+        ResourceRegistryHeader header{};
+        header.magic = g_ResourceRegistryMagic;
+        header.version = g_ResourceRegistryVersion;
+        header.recordCount = CAST_U32(records.size());
+        header.bankCount = CAST_U32(bank_names.size());
+        header.dependencyCount = CAST_U32(dependencies.size());
+        header.recordsOffset = sizeof(ResourceRegistryHeader);
+        header.dependenciesOffset = header.recordsOffset + vec_data_size(records);
+        header.banksOffset = header.dependenciesOffset + vec_data_size(dependencies);
+
+        // Written to a temporary file then moved into place, so a running engine never sees (or has mapped) a partially written registry
+        auto temp_filename = filename;
+        temp_filename += ".tmp";
+        {
+            BinaryWriter writer(temp_filename);
+            writer.write_array(std::span(&header, 1));
+            writer.write_array(std::span(records));
+            writer.write_array(std::span(dependencies));
+            for (const auto& bank_name : bank_names)
+            {
+                writer.write_u32(CAST_U32(bank_name.size()));
+                writer.write_bytes(std::as_bytes(std::span(bank_name)));
+            }
+        }
+
+        std::error_code error{};
+        std::filesystem::rename(temp_filename, filename, error);
+        if (error)
+        {
+            LOG_ERROR("ResourceRegistry - Failed to replace <{}>: {}", filename.string(), error.message());
+            std::filesystem::remove(temp_filename, error);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ResourceRegistry::is_valid() const
+    {
+        return m_isValid;
+    }
+
+    auto ResourceRegistry::find(ResourceId id) const -> const ResourceRegistryRecord*
+    {
+        const auto it =
+            std::lower_bound(m_records.begin(), m_records.end(), id, [](const auto& record, ResourceId value) { return record.id < value; });
+        if (it == m_records.end() || it->id != id)
+        {
+            return nullptr;
+        }
+
+        return &*it;
+    }
+
+    auto ResourceRegistry::get_records() const -> std::span<const ResourceRegistryRecord>
+    {
+        return m_records;
+    }
+
+    auto ResourceRegistry::get_dependencies(const ResourceRegistryRecord& record) const -> std::span<const ResourceId>
+    {
+        return m_dependencies.subspan(record.firstDependency, record.dependencyCount);
+    }
+
+    auto ResourceRegistry::get_bank_name(u16 bank_index) const -> const std::string&
+    {
+        ASSERT(bank_index < m_bankNames.size());
+        return m_bankNames[bank_index];
+    }
+
+}
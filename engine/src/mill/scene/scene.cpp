@@ -32,7 +32,7 @@ namespace mill
             transform.set_rotation(rotation);
 
             auto& static_mesh = entity.add_component<StaticMeshComponent>();
-            static_mesh.staticMesh = resources->get_handle(1998, true);
+            static_mesh.staticMesh = resources->get_handle(1998, ResourceLoadPriority::eImmediate);
         }
         {
             auto entity = create_entity();
@@ -46,7 +46,7 @@ namespace mill
             transform.set_rotation(rotation);
 
             auto& static_mesh = entity.add_component<StaticMeshComponent>();
-            static_mesh.staticMesh = resources->get_handle(1998, true);
+            static_mesh.staticMesh = resources->get_handle(1998, ResourceLoadPriority::eImmediate);
         }
         {
             auto entity = create_entity();
@@ -60,7 +60,7 @@ namespace mill
             transform.set_rotation(rotation);
 
             auto& static_mesh = entity.add_component<StaticMeshComponent>();
-            static_mesh.staticMesh = resources->get_handle(1998, true);
+            static_mesh.staticMesh = resources->get_handle(1998, ResourceLoadPriority::eImmediate);
         }
         {
             auto entity = create_entity();
@@ -74,7 +74,7 @@ namespace mill
             transform.set_rotation(rotation);
 
             auto& static_mesh = entity.add_component<StaticMeshComponent>();
-            static_mesh.staticMesh = resources->get_handle(1998, true);
+            static_mesh.staticMesh = resources->get_handle(1998, ResourceLoadPriority::eImmediate);
         }
     }
 
@@ -37,4 +37,6 @@ workspace "Mill Engine"
     group "Apps"
         include "apps/sandbox"
         include "apps/asset_browser"
+        include "apps/asset_baker"
+        include "apps/resource_bench"
     group ""
\ No newline at end of file